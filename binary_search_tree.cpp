@@ -1,8 +1,20 @@
 // binary_search_tree.cpp
 // Implements a Binary Search Tree (BST) with insert, search, and inorder traversal using dynamic memory allocation (new/delete). The BST maintains sorted order and allows efficient search, insertion, and traversal operations.
 #include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <climits>
 using namespace std;
 
+// Building with -DBST_STATS adds shape and search counters and a depth histogram dump;
+// without it the counters compile away entirely.
+#ifdef BST_STATS
+#define BST_STAT(stmt) stmt
+#else
+#define BST_STAT(stmt)
+#endif
+
 class Node
 {
 public:
@@ -12,49 +24,151 @@ public:
   Node(int val) : data(val), left(nullptr), right(nullptr) {}
 };
 
+// Forward cursor over the keys of a BST, in increasing order and below an exclusive upper bound.
+// The stack holds the ancestors still to be visited, so advancing costs amortized O(1).
+class Cursor
+{
+private:
+  vector<Node *> stack;
+  long long hi;
+
+public:
+  Cursor(Node *root, long long from, long long until) : hi(until)
+  {
+    // Push every node >= from on the path: these are exactly the pending inorder successors
+    while (root)
+    {
+      if (root->data >= from)
+      {
+        stack.push_back(root);
+        root = root->left;
+      }
+      else
+        root = root->right;
+    }
+  }
+  bool hasNext() const { return !stack.empty() && stack.back()->data < hi; }
+  // Returns the current key and advances; only valid while hasNext() is true
+  int next()
+  {
+    Node *node = stack.back();
+    stack.pop_back();
+    for (Node *curr = node->right; curr; curr = curr->left)
+      stack.push_back(curr);
+    return node->data;
+  }
+};
+
+#ifdef BST_STATS
+// Counters kept by a BST built with -DBST_STATS. Nodes never move once inserted,
+// so the depth histogram is maintained at insert time and reading it is O(1).
+struct TreeStats
+{
+  size_t nodes = 0;
+  size_t allocBytes = 0;
+  size_t searches = 0;
+  size_t comparisons = 0;     // Nodes compared against by search (one per level visited)
+  vector<size_t> depthCounts; // depthCounts[d] = nodes at depth d (the root has depth 0)
+
+  int maxDepth() const { return int(depthCounts.size()) - 1; }
+  double avgDepth() const
+  {
+    size_t sum = 0;
+    for (size_t d = 0; d < depthCounts.size(); d++)
+      sum += d * depthCounts[d];
+    return nodes ? double(sum) / nodes : 0;
+  }
+  double comparisonsPerSearch() const { return searches ? double(comparisons) / searches : 0; }
+};
+#endif
+
+// All operations are loop-based, so even a degenerate tree cannot overflow the call stack
 class BST
 {
 private:
   Node *root;
+  BST_STAT(TreeStats stats;)
   void insert(Node *&node, int val)
   {
-    if (!node)
+    Node **link = &node;
+    BST_STAT(size_t depth = 0;)
+    while (*link)
     {
-      node = new Node(val);
-      return;
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // If val == node->data, do nothing (no duplicates)
+      BST_STAT(depth++;)
     }
-    if (val < node->data)
-      insert(node->left, val);
-    else if (val > node->data)
-      insert(node->right, val);
-    // If val == node->data, do nothing (no duplicates)
+    *link = new Node(val);
+#ifdef BST_STATS
+    stats.nodes++;
+    stats.allocBytes += sizeof(Node);
+    if (stats.depthCounts.size() <= depth)
+      stats.depthCounts.resize(depth + 1);
+    stats.depthCounts[depth]++;
+#endif
   }
   bool search(Node *node, int val)
   {
-    if (!node)
-      return false;
-    if (node->data == val)
-      return true;
-    if (val < node->data)
-      return search(node->left, val);
-    else
-      return search(node->right, val);
+    BST_STAT(stats.searches++;)
+    while (node)
+    {
+      BST_STAT(stats.comparisons++;)
+      if (node->data == val)
+        return true;
+      node = val < node->data ? node->left : node->right;
+    }
+    return false;
   }
+  // Morris traversal: threads each predecessor's right pointer back to its successor, so no stack is needed
   void inorder(Node *node)
   {
-    if (!node)
-      return;
-    inorder(node->left);
-    cout << node->data << " ";
-    inorder(node->right);
+    while (node)
+    {
+      if (!node->left)
+      {
+        cout << node->data << " ";
+        node = node->right;
+        continue;
+      }
+      Node *pred = node->left;
+      while (pred->right && pred->right != node)
+        pred = pred->right;
+      if (!pred->right)
+      {
+        pred->right = node; // Create the thread and descend left
+        node = node->left;
+      }
+      else
+      {
+        pred->right = nullptr; // Left subtree done: remove the thread
+        cout << node->data << " ";
+        node = node->right;
+      }
+    }
   }
+  // Teardown without a stack: rotating left children up turns the tree into a right spine
   void destroy(Node *node)
   {
-    if (!node)
-      return;
-    destroy(node->left);
-    destroy(node->right);
-    delete node;
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
   }
 
 public:
@@ -67,6 +181,37 @@ public:
     inorder(root);
     cout << endl;
   }
+  // Cursor starting at the first key >= val
+  Cursor lowerBound(int val) const { return Cursor(root, val, (long long)INT_MAX + 1); }
+  // Cursor starting at the first key > val
+  Cursor upperBound(int val) const { return Cursor(root, (long long)val + 1, (long long)INT_MAX + 1); }
+  // Cursor over the keys in [lo, hi)
+  Cursor range(int lo, int hi) const { return Cursor(root, lo, hi); }
+  int rangeCount(int lo, int hi) const
+  {
+    int count = 0;
+    for (Cursor it = range(lo, hi); it.hasNext(); it.next())
+      count++;
+    return count;
+  }
+#ifdef BST_STATS
+  const TreeStats &treeStats() const { return stats; }
+  // Prints the counters, followed by one line per depth if histogram is set
+  void dumpStats(ostream &out, bool histogram = true) const
+  {
+    out << "nodes: " << stats.nodes << ", allocated: " << stats.allocBytes << " bytes"
+        << ", max depth: " << stats.maxDepth() << ", avg depth: " << stats.avgDepth()
+        << ", searches: " << stats.searches << ", comparisons/search: " << stats.comparisonsPerSearch() << endl;
+    if (!histogram)
+      return;
+    size_t widest = 0;
+    for (size_t count : stats.depthCounts)
+      widest = max(widest, count);
+    for (size_t d = 0; d < stats.depthCounts.size(); d++)
+      out << "  depth " << d << ": " << stats.depthCounts[d] << " "
+          << string(stats.depthCounts[d] * 50 / widest, '#') << endl;
+  }
+#endif
 };
 
 // Example usage
@@ -86,5 +231,35 @@ int main()
 
   int key = 4;
   cout << "Search " << key << ": " << (tree.search(key) ? "Found" : "Not Found") << endl;
+
+  cout << "Keys in [3, 7): ";
+  for (Cursor it = tree.range(3, 7); it.hasNext();)
+    cout << it.next() << " ";
+  cout << endl;
+  Cursor lb = tree.lowerBound(6), ub = tree.upperBound(6);
+  cout << "lowerBound(6): " << lb.next() << ", upperBound(6): " << ub.next() << endl;
+  cout << "Count in [0, 5): " << tree.rangeCount(0, 5) << endl;
+
+  // Sorted inserts build a degenerate (linked-list shaped) tree; nothing here recurses on its depth
+  BST chain;
+  const int n = 20000;
+  for (int i = 0; i < n; i++)
+    chain.insert(i);
+  cout << "Degenerate tree of " << n << " nodes, search " << n - 1 << ": "
+       << (chain.search(n - 1) ? "Found" : "Not Found") << endl;
+
+#ifdef BST_STATS
+  // Random insert order for comparison: average depth stays near 2 ln n
+  BST shuffled;
+  mt19937 rng(42);
+  for (int i = 0; i < n; i++)
+    shuffled.insert(static_cast<int>(rng() % (10 * n)));
+  for (int i = 0; i < n; i++)
+    shuffled.search(static_cast<int>(rng() % (10 * n)));
+  cout << "\nDegenerate tree: ";
+  chain.dumpStats(cout, false);
+  cout << "Random tree: ";
+  shuffled.dumpStats(cout);
+#endif
   return 0;
 }
\ No newline at end of file
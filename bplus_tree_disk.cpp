@@ -0,0 +1,529 @@
+// bplus_tree_disk.cpp
+// Implements a disk-resident B+tree of int keys for key sets that do not fit in RAM, with the same insert/search/range API as the BST.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// The file is an array of pages: page 0 holds MetaPage, the rest are inner pages that route by
+// separator keys and leaf pages chained left to right. Pages are read and written whole with
+// POSIX pread/pwrite, in the host byte order.
+const size_t PAGE_SIZE = 4096;
+const uint32_t NO_PAGE = 0xFFFFFFFF;
+const uint32_t DISK_VERSION = 1;
+const char DISK_MAGIC[8] = {'B', 'P', 'T', 'R', 'E', 'E', '\0', '\0'};
+
+struct MetaPage
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t root;      // Page number of the root
+  uint32_t pageCount; // Pages in the file, the meta page included
+  uint32_t height;    // Levels, leaves included
+  uint64_t keyCount;
+};
+
+struct PageHeader
+{
+  uint16_t leaf;
+  uint16_t count; // Keys in the page
+  uint32_t next;  // Right sibling (leaves only)
+};
+
+const int LEAF_CAPACITY = (PAGE_SIZE - sizeof(PageHeader)) / sizeof(int32_t);
+const int INNER_CAPACITY = (PAGE_SIZE - sizeof(PageHeader) - sizeof(uint32_t)) / (sizeof(int32_t) + sizeof(uint32_t));
+
+struct LeafPage
+{
+  PageHeader header;
+  int32_t keys[LEAF_CAPACITY];
+};
+
+// child[i] holds the keys < keys[i]; child[count] holds the rest
+struct InnerPage
+{
+  PageHeader header;
+  int32_t keys[INNER_CAPACITY];
+  uint32_t child[INNER_CAPACITY + 1];
+};
+
+static_assert(sizeof(MetaPage) <= PAGE_SIZE && sizeof(LeafPage) <= PAGE_SIZE && sizeof(InnerPage) <= PAGE_SIZE,
+              "Page layouts must fit in one page");
+
+struct PoolStats
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;    // Page reads from the file
+  uint64_t writes = 0;    // Dirty pages written back
+  uint64_t evictions = 0;
+};
+
+// Fixed set of page frames over one file. Pinned frames are never evicted; the CLOCK hand
+// gives every unpinned frame a second chance if it was used since the hand last passed.
+class BufferPool
+{
+private:
+  struct Frame
+  {
+    uint32_t page = NO_PAGE;
+    int pins = 0;
+    bool dirty = false;
+    bool referenced = false;
+  };
+  int fd;
+  char *memory; // frames.size() page-aligned pages
+  vector<Frame> frames;
+  unordered_map<uint32_t, size_t> table; // Page number -> frame
+  size_t hand;
+  PoolStats stats;
+
+  char *frameData(size_t f) { return memory + f * PAGE_SIZE; }
+  void writeBack(size_t f)
+  {
+    if (pwrite(fd, frameData(f), PAGE_SIZE, off_t(frames[f].page) * PAGE_SIZE) != ssize_t(PAGE_SIZE))
+      throw runtime_error("pwrite failed for page " + to_string(frames[f].page));
+    frames[f].dirty = false;
+    stats.writes++;
+  }
+  size_t victim()
+  {
+    for (size_t step = 0; step < 2 * frames.size(); step++)
+    {
+      size_t f = hand;
+      hand = (hand + 1) % frames.size();
+      Frame &frame = frames[f];
+      if (frame.pins > 0)
+        continue;
+      if (frame.referenced)
+      {
+        frame.referenced = false;
+        continue;
+      }
+      if (frame.page != NO_PAGE)
+      {
+        if (frame.dirty)
+          writeBack(f);
+        table.erase(frame.page);
+        stats.evictions++;
+      }
+      return f;
+    }
+    throw runtime_error("Buffer pool exhausted: every frame is pinned");
+  }
+  // Frame holding page, loaded from the file unless fresh is set
+  size_t fetch(uint32_t page, bool fresh)
+  {
+    auto it = table.find(page);
+    if (it != table.end())
+    {
+      stats.hits++;
+      return it->second;
+    }
+    size_t f = victim();
+    if (fresh)
+      memset(frameData(f), 0, PAGE_SIZE);
+    else
+    {
+      stats.misses++;
+      if (pread(fd, frameData(f), PAGE_SIZE, off_t(page) * PAGE_SIZE) != ssize_t(PAGE_SIZE))
+        throw runtime_error("pread failed for page " + to_string(page));
+    }
+    frames[f] = Frame();
+    frames[f].page = page;
+    table[page] = f;
+    return f;
+  }
+
+public:
+  BufferPool(int file, size_t pages) : fd(file), frames(pages), hand(0)
+  {
+    memory = static_cast<char *>(aligned_alloc(PAGE_SIZE, pages * PAGE_SIZE));
+    if (!memory)
+      throw runtime_error("Cannot allocate buffer pool");
+  }
+  ~BufferPool() { free(memory); }
+  BufferPool(const BufferPool &) = delete;
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  char *pin(uint32_t page, bool fresh = false)
+  {
+    size_t f = fetch(page, fresh);
+    frames[f].pins++;
+    frames[f].referenced = true;
+    if (fresh)
+      frames[f].dirty = true;
+    return frameData(f);
+  }
+  void unpin(uint32_t page, bool dirty)
+  {
+    Frame &frame = frames[table.at(page)];
+    frame.pins--;
+    frame.dirty |= dirty;
+  }
+  void flushAll()
+  {
+    for (size_t f = 0; f < frames.size(); f++)
+      if (frames[f].page != NO_PAGE && frames[f].dirty)
+        writeBack(f);
+  }
+  size_t capacity() const { return frames.size(); }
+  const PoolStats &poolStats() const { return stats; }
+  void resetStats() { stats = PoolStats(); }
+};
+
+// Keeps a page pinned for the lifetime of the guard
+class PageGuard
+{
+private:
+  BufferPool &pool;
+  uint32_t page;
+  char *data;
+  bool dirty;
+
+public:
+  PageGuard(BufferPool &p, uint32_t id, bool fresh = false) : pool(p), page(id), data(p.pin(id, fresh)), dirty(false) {}
+  ~PageGuard() { pool.unpin(page, dirty); }
+  PageGuard(const PageGuard &) = delete;
+  PageGuard &operator=(const PageGuard &) = delete;
+
+  PageHeader *header() { return reinterpret_cast<PageHeader *>(data); }
+  LeafPage *leaf() { return reinterpret_cast<LeafPage *>(data); }
+  InnerPage *inner() { return reinterpret_cast<InnerPage *>(data); }
+  void markDirty() { dirty = true; }
+};
+
+// Yields the keys in [lo, hi) in increasing order, keeping only the current leaf pinned, so a scan
+// over more keys than fit in RAM never holds more than one page. The tree must not be modified
+// while a cursor is open.
+class Cursor
+{
+private:
+  BufferPool &pool;
+  unique_ptr<PageGuard> guard; // Current leaf; empty once the scan is done
+  int pos;
+  int hi;
+
+  // Follows the leaf chain past exhausted leaves and stops the scan at hi
+  void settle()
+  {
+    while (guard && pos == guard->leaf()->header.count)
+    {
+      uint32_t next = guard->leaf()->header.next;
+      guard.reset();
+      if (next != NO_PAGE)
+      {
+        guard = make_unique<PageGuard>(pool, next);
+        pos = 0;
+      }
+    }
+    if (guard && guard->leaf()->keys[pos] >= hi)
+      guard.reset();
+  }
+
+public:
+  Cursor(BufferPool &p, uint32_t leafPage, int lo, int until) : pool(p), guard(make_unique<PageGuard>(p, leafPage)), hi(until)
+  {
+    LeafPage *leaf = guard->leaf();
+    pos = int(lower_bound(leaf->keys, leaf->keys + leaf->header.count, lo) - leaf->keys);
+    settle();
+  }
+  bool hasNext() const { return guard != nullptr; }
+  // Returns the current key and advances; only valid while hasNext() is true
+  int next()
+  {
+    int key = guard->leaf()->keys[pos++];
+    settle();
+    return key;
+  }
+};
+
+// Owns a file descriptor, so a constructor that throws after opening the file still closes it
+class FileHandle
+{
+public:
+  const int fd;
+  explicit FileHandle(int file) : fd(file) {}
+  ~FileHandle() { close(fd); }
+  FileHandle(const FileHandle &) = delete;
+  FileHandle &operator=(const FileHandle &) = delete;
+};
+
+class DiskBPlusTree
+{
+private:
+  FileHandle file;
+  BufferPool pool;
+  MetaPage meta;
+  string path;
+
+  struct Split
+  {
+    bool happened;
+    int32_t key;    // Smallest key of the new right page
+    uint32_t right;
+  };
+
+  // Validates the arguments before acquiring anything, then opens path
+  static int openFile(const string &path, size_t poolPages)
+  {
+    if (poolPages < 16)
+      throw invalid_argument("Buffer pool needs at least 16 pages");
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+      throw runtime_error("Cannot open " + path);
+    return fd;
+  }
+  void writeMeta()
+  {
+    alignas(PAGE_SIZE) char page[PAGE_SIZE] = {};
+    memcpy(page, &meta, sizeof(meta));
+    if (pwrite(file.fd, page, PAGE_SIZE, 0) != ssize_t(PAGE_SIZE))
+      throw runtime_error("Failed to write meta page of " + path);
+  }
+  uint32_t allocatePage() { return meta.pageCount++; }
+
+  Split insertAt(uint32_t page, int32_t val, bool &added)
+  {
+    PageGuard guard(pool, page);
+    if (guard.header()->leaf)
+    {
+      LeafPage *leaf = guard.leaf();
+      int count = leaf->header.count;
+      int pos = int(lower_bound(leaf->keys, leaf->keys + count, val) - leaf->keys);
+      if (pos < count && leaf->keys[pos] == val)
+        return {false, 0, NO_PAGE}; // No duplicates
+      added = true;
+      guard.markDirty();
+      if (count < LEAF_CAPACITY)
+      {
+        copy_backward(leaf->keys + pos, leaf->keys + count, leaf->keys + count + 1);
+        leaf->keys[pos] = val;
+        leaf->header.count++;
+        return {false, 0, NO_PAGE};
+      }
+      // Full: the lower half stays, the upper half moves to a new right sibling
+      vector<int32_t> all(leaf->keys, leaf->keys + count);
+      all.insert(all.begin() + pos, val);
+      uint32_t rightId = allocatePage();
+      PageGuard rightGuard(pool, rightId, true);
+      LeafPage *right = rightGuard.leaf();
+      int half = int(all.size() / 2);
+      copy(all.begin(), all.begin() + half, leaf->keys);
+      copy(all.begin() + half, all.end(), right->keys);
+      right->header = {1, uint16_t(all.size() - half), leaf->header.next};
+      leaf->header.count = uint16_t(half);
+      leaf->header.next = rightId;
+      return {true, right->keys[0], rightId};
+    }
+
+    InnerPage *inner = guard.inner();
+    int count = inner->header.count;
+    int i = int(upper_bound(inner->keys, inner->keys + count, val) - inner->keys);
+    Split below = insertAt(inner->child[i], val, added);
+    if (!below.happened)
+      return below;
+    guard.markDirty();
+    if (count < INNER_CAPACITY)
+    {
+      copy_backward(inner->keys + i, inner->keys + count, inner->keys + count + 1);
+      copy_backward(inner->child + i + 1, inner->child + count + 1, inner->child + count + 2);
+      inner->keys[i] = below.key;
+      inner->child[i + 1] = below.right;
+      inner->header.count++;
+      return {false, 0, NO_PAGE};
+    }
+    // Full: the middle key moves up, the keys and children right of it go to a new page
+    vector<int32_t> keys(inner->keys, inner->keys + count);
+    vector<uint32_t> children(inner->child, inner->child + count + 1);
+    keys.insert(keys.begin() + i, below.key);
+    children.insert(children.begin() + i + 1, below.right);
+    int mid = int(keys.size() / 2);
+    uint32_t rightId = allocatePage();
+    PageGuard rightGuard(pool, rightId, true);
+    InnerPage *right = rightGuard.inner();
+    copy(keys.begin(), keys.begin() + mid, inner->keys);
+    copy(children.begin(), children.begin() + mid + 1, inner->child);
+    inner->header.count = uint16_t(mid);
+    copy(keys.begin() + mid + 1, keys.end(), right->keys);
+    copy(children.begin() + mid + 1, children.end(), right->child);
+    right->header = {0, uint16_t(keys.size() - mid - 1), NO_PAGE};
+    return {true, keys[mid], rightId};
+  }
+  // Leaf page that would hold val
+  uint32_t findLeaf(int32_t val)
+  {
+    uint32_t page = meta.root;
+    while (true)
+    {
+      PageGuard guard(pool, page);
+      if (guard.header()->leaf)
+        return page;
+      InnerPage *inner = guard.inner();
+      page = inner->child[upper_bound(inner->keys, inner->keys + inner->header.count, val) - inner->keys];
+    }
+  }
+
+public:
+  // Opens the tree stored at path, creating an empty one if the file is empty
+  DiskBPlusTree(const string &filePath, size_t poolPages)
+      : file(openFile(filePath, poolPages)), pool(file.fd, poolPages), path(filePath)
+  {
+    alignas(PAGE_SIZE) char page[PAGE_SIZE];
+    ssize_t got = pread(file.fd, page, PAGE_SIZE, 0);
+    if (got == 0)
+    {
+      memcpy(meta.magic, DISK_MAGIC, sizeof(DISK_MAGIC));
+      meta.version = DISK_VERSION;
+      meta.root = 1;
+      meta.pageCount = 2;
+      meta.height = 1;
+      meta.keyCount = 0;
+      {
+        PageGuard root(pool, meta.root, true);
+        root.leaf()->header = {1, 0, NO_PAGE};
+      }
+      writeMeta();
+      return;
+    }
+    memcpy(&meta, page, sizeof(meta));
+    if (got != ssize_t(PAGE_SIZE) || memcmp(meta.magic, DISK_MAGIC, sizeof(DISK_MAGIC)) != 0 || meta.version != DISK_VERSION)
+      throw runtime_error("Not a B+tree file: " + path);
+  }
+  ~DiskBPlusTree()
+  {
+    try
+    {
+      flush();
+    }
+    catch (const exception &e)
+    {
+      cerr << e.what() << endl;
+    }
+  }
+  DiskBPlusTree(const DiskBPlusTree &) = delete;
+  DiskBPlusTree &operator=(const DiskBPlusTree &) = delete;
+
+  void insert(int val)
+  {
+    bool added = false;
+    Split top = insertAt(meta.root, val, added);
+    if (top.happened)
+    {
+      // The root split: grow the tree by one level
+      uint32_t rootId = allocatePage();
+      PageGuard guard(pool, rootId, true);
+      InnerPage *root = guard.inner();
+      root->header = {0, 1, NO_PAGE};
+      root->keys[0] = top.key;
+      root->child[0] = meta.root;
+      root->child[1] = top.right;
+      meta.root = rootId;
+      meta.height++;
+    }
+    if (added)
+      meta.keyCount++;
+  }
+  bool search(int val)
+  {
+    PageGuard guard(pool, findLeaf(val));
+    LeafPage *leaf = guard.leaf();
+    return binary_search(leaf->keys, leaf->keys + leaf->header.count, val);
+  }
+  // Cursor over the keys in [lo, hi)
+  Cursor range(int lo, int hi) { return Cursor(pool, findLeaf(lo), lo, hi); }
+  // Writes every dirty page and the meta page back to the file
+  void flush()
+  {
+    pool.flushAll();
+    writeMeta();
+  }
+  uint64_t size() const { return meta.keyCount; }
+  uint32_t pages() const { return meta.pageCount; }
+  uint32_t height() const { return meta.height; }
+  const PoolStats &poolStats() const { return pool.poolStats(); }
+  void resetStats() { pool.resetStats(); }
+};
+
+// Usage: ./bplus_tree_disk [n] [pool_pages] [queries]
+int main(int argc, char **argv)
+{
+  const string demoPath = "bplus_tree_disk_demo.db";
+  remove(demoPath.c_str());
+  {
+    DiskBPlusTree tree(demoPath, 16);
+    for (int val : {50, 30, 70, 20, 40, 60, 80})
+      tree.insert(val);
+  }
+  {
+    DiskBPlusTree reopened(demoPath, 16);
+    cout << "Reopened tree: " << reopened.size() << " keys, search 40: " << (reopened.search(40) ? "Found" : "Not Found")
+         << ", search 45: " << (reopened.search(45) ? "Found" : "Not Found") << endl;
+    cout << "Keys in [30, 70): ";
+    for (Cursor it = reopened.range(30, 70); it.hasNext();)
+      cout << it.next() << " ";
+    cout << endl;
+  }
+  remove(demoPath.c_str());
+
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  size_t poolPages = argc > 2 ? strtoull(argv[2], nullptr, 10) : 256;
+  int q = argc > 3 ? atoi(argv[3]) : 1000000;
+  const string path = "bplus_tree_disk.db";
+  remove(path.c_str());
+  bool ok = true;
+  {
+    DiskBPlusTree tree(path, poolPages);
+    vector<int> keys(n);
+    for (int i = 0; i < n; i++)
+      keys[i] = 2 * i; // Even keys, so odd queries miss
+    mt19937 rng(42);
+    shuffle(keys.begin(), keys.end(), rng);
+    auto t0 = chrono::steady_clock::now();
+    for (int key : keys)
+      tree.insert(key);
+    tree.flush();
+    double insertSec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "\n" << n << " inserts: " << n / insertSec / 1e6 << " M/sec, " << tree.pages() << " pages ("
+         << tree.pages() * PAGE_SIZE / 1024 << " KB), height " << tree.height() << ", pool " << poolPages
+         << " pages (" << poolPages * PAGE_SIZE / 1024 << " KB)" << endl;
+    int scanned = 0;
+    for (Cursor it = tree.range(0, 2 * n); it.hasNext(); it.next())
+      scanned++;
+    ok = scanned == n;
+
+    // Queries drawn from the lowest fraction of the key range touch about that fraction of the leaves
+    cout << "\n=== " << q << " lookups per working set ===" << endl;
+    for (double fraction : {1.0 / 16, 1.0 / 8, 1.0 / 4, 1.0 / 2, 1.0})
+    {
+      int span = max(1, int(2 * n * fraction));
+      vector<int> queries(q);
+      for (int &query : queries)
+        query = int(rng() % span);
+      for (int i = 0; i < q / 10; i++) // Warm the pool up
+        tree.search(queries[i]);
+      tree.resetStats();
+      size_t found = 0;
+      auto t1 = chrono::steady_clock::now();
+      for (int query : queries)
+        found += tree.search(query);
+      double sec = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+      const PoolStats &stats = tree.poolStats();
+      cout << "working set ~" << size_t(tree.pages() * fraction) << " pages: " << q / sec / 1e6 << " M lookups/sec, hit rate "
+           << double(stats.hits) / (stats.hits + stats.misses) << ", " << found << " hits" << endl;
+    }
+  }
+  remove(path.c_str());
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+// bst_batch_search.cpp
+// Adds a batched search to the Binary Search Tree: many lookups walk the tree in lock-step, each advancing one level per round and prefetching its next node, so the cache misses of different keys overlap instead of being paid one after another. Results go into a caller-provided bitmap. main() benchmarks batched against one-at-a-time search.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  // Number of lookups kept in flight by searchBatch
+  static const int GROUP = 16;
+
+  BST() : root(nullptr) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+
+  // Looks up keys[0..n) and sets bit i of bitmap (bitmap[i / 64], bit i % 64) when keys[i] is present.
+  // bitmap must hold at least (n + 63) / 64 words; it is cleared first.
+  void searchBatch(const int *keys, size_t n, uint64_t *bitmap) const
+  {
+    for (size_t w = 0; w < (n + 63) / 64; w++)
+      bitmap[w] = 0;
+    if (!root)
+      return;
+
+    struct Cursor
+    {
+      const Node *node;
+      size_t index;
+    };
+    Cursor slots[GROUP];
+    int active = 0;
+    size_t next = 0;
+    while (active < GROUP && next < n)
+      slots[active++] = {root, next++};
+
+    int i = 0;
+    while (active > 0)
+    {
+      Cursor &c = slots[i];
+      int key = keys[c.index];
+      const Node *node = c.node;
+      if (node && node->data != key)
+      {
+        // Step one level and start fetching the child; it is touched again only after the other cursors
+        c.node = key < node->data ? node->left : node->right;
+        __builtin_prefetch(c.node);
+      }
+      else
+      {
+        if (node)
+          bitmap[c.index / 64] |= uint64_t(1) << (c.index % 64);
+        if (next < n)
+        {
+          c = {root, next++};
+        }
+        else
+        {
+          // No more keys: move the last active cursor into this slot
+          c = slots[--active];
+          if (i >= active)
+            i = 0;
+          continue;
+        }
+      }
+      if (++i >= active)
+        i = 0;
+    }
+  }
+};
+
+// Usage: ./bst_batch_search [n] [queries]
+int main(int argc, char **argv)
+{
+  BST tree;
+  for (int val : {5, 3, 7, 2, 4, 6, 8})
+    tree.insert(val);
+  vector<int> probe = {1, 2, 3, 9, 8, 5, 0, 7};
+  uint64_t bits[1];
+  tree.searchBatch(probe.data(), probe.size(), bits);
+  for (size_t i = 0; i < probe.size(); i++)
+    cout << "Search " << probe[i] << ": " << ((bits[0] >> i) & 1 ? "Found" : "Not Found") << endl;
+
+  size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+  size_t q = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+  mt19937 rng(42);
+  vector<int> keys(n);
+  BST big;
+  for (int &key : keys)
+  {
+    key = static_cast<int>(rng());
+    big.insert(key);
+  }
+  vector<int> queries(q);
+  for (size_t i = 0; i < q; i++)
+    queries[i] = i % 2 ? keys[rng() % n] : static_cast<int>(rng());
+
+  using Clock = chrono::steady_clock;
+  auto t0 = Clock::now();
+  size_t hitsSingle = 0;
+  for (int key : queries)
+    hitsSingle += big.search(key);
+  auto t1 = Clock::now();
+  vector<uint64_t> bitmap((q + 63) / 64);
+  big.searchBatch(queries.data(), q, bitmap.data());
+  auto t2 = Clock::now();
+  size_t hitsBatch = 0;
+  for (uint64_t word : bitmap)
+    hitsBatch += __builtin_popcountll(word);
+
+  cout << "\n=== " << q << " lookups against " << n << " random keys ===" << endl;
+  cout << "search():      " << q / chrono::duration<double>(t1 - t0).count() / 1e6 << " M lookups/sec (" << hitsSingle << " hits)" << endl;
+  cout << "searchBatch(): " << q / chrono::duration<double>(t2 - t1).count() / 1e6 << " M lookups/sec (" << hitsBatch << " hits)" << endl;
+  return hitsSingle == hitsBatch ? 0 : 1;
+}
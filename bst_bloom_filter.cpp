@@ -0,0 +1,282 @@
+// bst_bloom_filter.cpp
+// Puts an optional blocked Bloom filter in front of a Binary Search Tree. insert adds every key to the filter, and search first asks the filter: a "definitely absent" answer returns without touching the tree. The filter is sized from the expected key count and a target false-positive rate, and counters report how many tree walks it avoided.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+using namespace std;
+
+// Bloom filter split into 512-bit blocks: all k probes of a key land in one cache line. Uneven block
+// loads make a blocked filter less accurate than the classic formula predicts for the same size, so the
+// block count and k come from the blocked filter's own false-positive estimate instead.
+class BloomFilter
+{
+private:
+  struct alignas(64) Block
+  {
+    uint64_t words[8];
+  };
+  vector<Block> blocks;
+  int hashes; // Bits set per key (k)
+
+  static uint64_t mix(int key)
+  {
+    uint64_t h = static_cast<uint32_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  // Next probe position in a block. Each probe takes the top 9 bits of an LCG step over the full 64-bit
+  // hash: a double-hashing stride (h1 + i * h2) & 511 allows only 2^17 probe patterns per block,
+  // which puts a floor of about 1e-4 under the false-positive rate.
+  static uint32_t nextBit(uint64_t &stream)
+  {
+    stream = stream * 6364136223846793005ULL + 1442695040888963407ULL;
+    return uint32_t(stream >> 55);
+  }
+  // Expected false-positive rate with k probes when blocks hold keysPerBlock keys on average:
+  // block loads are Poisson distributed, and a block holding i keys is a 512-bit classic filter
+  static double blockedRate(double keysPerBlock, int k)
+  {
+    double rate = 0;
+    int last = int(keysPerBlock + 10 * sqrt(keysPerBlock) + 10);
+    for (int i = 0; i <= last; i++)
+    {
+      double load = exp(i * log(keysPerBlock) - keysPerBlock - lgamma(i + 1.0));
+      rate += load * pow(1 - pow(1 - 1.0 / 512, double(i) * k), k);
+    }
+    return rate;
+  }
+
+public:
+  BloomFilter(size_t expectedKeys, double falsePositiveRate)
+  {
+    if (expectedKeys == 0 || falsePositiveRate <= 0 || falsePositiveRate >= 1)
+      throw invalid_argument("Bloom filter needs expectedKeys > 0 and 0 < falsePositiveRate < 1");
+    // Start from the classic size, m = -n ln p / (ln 2)^2 bits, then add blocks until the best k meets the target
+    double bits = -double(expectedKeys) * log(falsePositiveRate) / (log(2.0) * log(2.0));
+    size_t count = max<size_t>(1, size_t(ceil(bits / 512)));
+    while (true)
+    {
+      double best = 1;
+      for (int k = 1; k <= 32; k++)
+      {
+        double rate = blockedRate(double(expectedKeys) / count, k);
+        if (rate < best)
+        {
+          best = rate;
+          hashes = k;
+        }
+      }
+      if (best <= falsePositiveRate)
+        break;
+      count += max<size_t>(1, count / 32);
+    }
+    blocks.resize(count);
+  }
+  void add(int key)
+  {
+    uint64_t h = mix(key);
+    Block &block = blocks[(h >> 32) % blocks.size()];
+    uint64_t stream = h;
+    for (int i = 0; i < hashes; i++)
+    {
+      uint32_t bit = nextBit(stream);
+      block.words[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+  }
+  bool mayContain(int key) const
+  {
+    uint64_t h = mix(key);
+    const Block &block = blocks[(h >> 32) % blocks.size()];
+    uint64_t stream = h;
+    for (int i = 0; i < hashes; i++)
+    {
+      uint32_t bit = nextBit(stream);
+      if (!(block.words[bit / 64] >> (bit % 64) & 1))
+        return false;
+    }
+    return true;
+  }
+  size_t bytes() const { return blocks.size() * sizeof(Block); }
+  int hashCount() const { return hashes; }
+};
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+struct SearchStats
+{
+  uint64_t lookups = 0;
+  uint64_t filterRejects = 0;  // Tree walks avoided
+  uint64_t treeWalks = 0;      // Lookups the filter let through
+  uint64_t falsePositives = 0; // Walks that found nothing
+};
+
+class BST
+{
+private:
+  Node *root;
+  BloomFilter *filter; // nullptr when the filter is disabled
+  mutable SearchStats stats;
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+  bool walk(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+
+public:
+  BST() : root(nullptr), filter(nullptr) {}
+  ~BST()
+  {
+    destroy(root);
+    delete filter;
+  }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  // Builds a filter sized for expectedKeys and loads the keys already in the tree
+  void enableFilter(size_t expectedKeys, double falsePositiveRate)
+  {
+    BloomFilter *fresh = new BloomFilter(expectedKeys, falsePositiveRate);
+    vector<Node *> stack;
+    if (root)
+      stack.push_back(root);
+    while (!stack.empty())
+    {
+      Node *node = stack.back();
+      stack.pop_back();
+      fresh->add(node->data);
+      if (node->left)
+        stack.push_back(node->left);
+      if (node->right)
+        stack.push_back(node->right);
+    }
+    delete filter;
+    filter = fresh;
+  }
+  void disableFilter()
+  {
+    delete filter;
+    filter = nullptr;
+  }
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+    if (filter)
+      filter->add(val);
+  }
+  bool search(int val) const
+  {
+    stats.lookups++;
+    if (filter && !filter->mayContain(val))
+    {
+      stats.filterRejects++;
+      return false;
+    }
+    stats.treeWalks++;
+    bool found = walk(val);
+    if (!found && filter)
+      stats.falsePositives++;
+    return found;
+  }
+  const SearchStats &searchStats() const { return stats; }
+  void resetStats() { stats = SearchStats(); }
+  size_t filterBytes() const { return filter ? filter->bytes() : 0; }
+};
+
+// Usage: ./bst_bloom_filter [n] [queries] [fp_rate]
+int main(int argc, char **argv)
+{
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int q = argc > 2 ? atoi(argv[2]) : 5000000;
+  double fpRate = argc > 3 ? atof(argv[3]) : 0.01;
+
+  BST tree;
+  tree.enableFilter(n, fpRate);
+  mt19937 rng(42);
+  vector<int> keys(n);
+  for (int &key : keys)
+  {
+    key = static_cast<int>(rng() & ~1u); // Keys are even ...
+    tree.insert(key);
+  }
+  // ... and 90% of the queries are odd, so they miss at a random point of the key range
+  vector<int> queries(q);
+  for (int i = 0; i < q; i++)
+    queries[i] = i % 10 == 0 ? keys[rng() % n] : static_cast<int>(rng() | 1u);
+
+  using Clock = chrono::steady_clock;
+  size_t hitsFiltered = 0, hitsPlain = 0;
+  auto t0 = Clock::now();
+  for (int key : queries)
+    hitsFiltered += tree.search(key);
+  auto t1 = Clock::now();
+  SearchStats stats = tree.searchStats();
+  size_t filterBytes = tree.filterBytes();
+  tree.disableFilter();
+  auto t2 = Clock::now();
+  for (int key : queries)
+    hitsPlain += tree.search(key);
+  auto t3 = Clock::now();
+
+  cout << "=== " << q << " lookups (90% misses) on " << n << " keys ===" << endl;
+  cout << "filter: " << filterBytes / 1024 << " KB for target false-positive rate " << fpRate << endl;
+  cout << "walks avoided: " << stats.filterRejects << ", walks taken: " << stats.treeWalks
+       << ", false positives: " << stats.falsePositives << " ("
+       << double(stats.falsePositives) / (stats.filterRejects + stats.falsePositives) << " of misses)" << endl;
+  cout << "with filter:    " << q / chrono::duration<double>(t1 - t0).count() / 1e6 << " M lookups/sec (" << hitsFiltered << " hits)" << endl;
+  cout << "without filter: " << q / chrono::duration<double>(t3 - t2).count() / 1e6 << " M lookups/sec (" << hitsPlain << " hits)" << endl;
+  return hitsFiltered == hitsPlain ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+// bst_bulk_load.cpp
+// Builds a perfectly balanced Binary Search Tree from sorted input in O(n) time. All nodes live in one contiguous block laid out in key order, with the middle key of every range becoming the subtree root. Keys can come from an array or from a sorted text file; later inserts still work and use new/delete as usual.
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <functional>
+#include <string>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdio>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+  Node *block;      // Contiguous storage owned by the tree after a bulk build
+  size_t blockSize; // Number of nodes in block
+
+  // std::less gives a total order even for pointers into unrelated allocations, unlike the raw operators
+  bool inBlock(const Node *node) const
+  {
+    return !less<const Node *>()(node, block) && less<const Node *>()(node, block + blockSize);
+  }
+
+  // Node for keys[mid] is placed at block[mid], so the block is in inorder order
+  Node *build(const int *keys, size_t lo, size_t hi)
+  {
+    if (lo == hi)
+      return nullptr;
+    size_t mid = lo + (hi - lo) / 2;
+    Node *node = new (block + mid) Node(keys[mid]);
+    node->left = build(keys, lo, mid);
+    node->right = build(keys, mid + 1, hi);
+    return node;
+  }
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        if (!inBlock(node))
+          delete node;
+        node = next;
+      }
+    }
+    ::operator delete(block);
+    block = nullptr;
+    blockSize = 0;
+  }
+
+public:
+  BST() : root(nullptr), block(nullptr), blockSize(0) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  BST(BST &&other) : root(other.root), block(other.block), blockSize(other.blockSize)
+  {
+    other.root = nullptr;
+    other.block = nullptr;
+    other.blockSize = 0;
+  }
+
+  // Builds a balanced tree from strictly increasing keys with a single allocation
+  static BST fromSorted(const int *keys, size_t n)
+  {
+    for (size_t i = 1; i < n; i++)
+    {
+      if (keys[i - 1] >= keys[i])
+        throw invalid_argument("Bulk load input must be strictly increasing");
+    }
+    BST tree;
+    if (n == 0)
+      return tree;
+    tree.block = static_cast<Node *>(::operator new(n * sizeof(Node)));
+    tree.blockSize = n;
+    tree.root = tree.build(keys, 0, n);
+    return tree;
+  }
+  static BST fromSorted(const vector<int> &keys) { return fromSorted(keys.data(), keys.size()); }
+  // Reads whitespace-separated, strictly increasing integers from a text file
+  static BST fromSortedFile(const string &path)
+  {
+    ifstream in(path);
+    if (!in)
+      throw runtime_error("Cannot open " + path);
+    vector<int> keys;
+    int key;
+    while (in >> key)
+      keys.push_back(key);
+    if (!in.eof())
+      throw runtime_error("Malformed key in " + path);
+    return fromSorted(keys);
+  }
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+};
+
+// Usage: ./bst_bulk_load [n] [insert_n]
+int main(int argc, char **argv)
+{
+  BST tree = BST::fromSorted({2, 3, 4, 5, 6, 7, 8});
+  tree.insert(9);
+  cout << "Inorder traversal: ";
+  tree.inorder();
+  cout << "Search 4: " << (tree.search(4) ? "Found" : "Not Found") << endl;
+
+  try
+  {
+    BST::fromSorted({1, 3, 2});
+  }
+  catch (const exception &e)
+  {
+    cout << "Unsorted input: " << e.what() << endl;
+  }
+
+  using Clock = chrono::steady_clock;
+  int n = argc > 1 ? atoi(argv[1]) : 10000000;
+  int insertN = argc > 2 ? atoi(argv[2]) : 20000;
+
+  // One-by-one insertion of sorted keys is quadratic, so it is timed at a smaller size
+  auto t0 = Clock::now();
+  {
+    BST slow;
+    for (int i = 0; i < insertN; i++)
+      slow.insert(i);
+  }
+  auto t1 = Clock::now();
+  cout << "\ninsert() x " << insertN << " sorted keys: "
+       << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++)
+    keys[i] = 2 * i;
+  t0 = Clock::now();
+  {
+    BST fast = BST::fromSorted(keys);
+    t1 = Clock::now();
+    cout << "fromSorted() x " << n << " keys: " << chrono::duration<double, milli>(t1 - t0).count()
+         << " ms, search " << 2 * (n - 1) << ": " << (fast.search(2 * (n - 1)) ? "Found" : "Not Found") << endl;
+  }
+
+  const char *path = "bst_bulk_load_keys.txt";
+  {
+    ofstream out(path);
+    for (int key : keys)
+      out << key << '\n';
+  }
+  t0 = Clock::now();
+  {
+    BST fromFile = BST::fromSortedFile(path);
+    t1 = Clock::now();
+  }
+  cout << "fromSortedFile() x " << n << " keys: " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+  remove(path);
+  return 0;
+}
@@ -0,0 +1,188 @@
+// bst_eytzinger_index.cpp
+// Freezes a Binary Search Tree into an immutable Eytzinger (BFS-order) array: the children of slot k are slots 2k and 2k+1, so a lookup walks one contiguous array with a branchless step per level and prefetches the descendants several levels ahead. main() benchmarks search throughput against the pointer tree.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class EytzingerIndex
+{
+private:
+  vector<int> slots; // 1-based: slots[0] is padding so that children of k are 2k and 2k+1
+  size_t n;
+
+  // Fills the tree positions in inorder, which places the sorted keys in BFS order
+  size_t fill(const vector<int> &sorted, size_t i, size_t k)
+  {
+    if (k <= n)
+    {
+      i = fill(sorted, i, 2 * k);
+      slots[k] = sorted[i++];
+      i = fill(sorted, i, 2 * k + 1);
+    }
+    return i;
+  }
+
+public:
+  explicit EytzingerIndex(const vector<int> &sorted) : slots(sorted.size() + 1), n(sorted.size())
+  {
+    slots[0] = INT_MIN;
+    fill(sorted, 0, 1);
+  }
+
+  bool search(int val) const
+  {
+    const int *base = slots.data();
+    size_t k = 1;
+    while (k <= n)
+    {
+      // Prefetch the 16 descendants four levels down (one 64-byte cache line)
+      __builtin_prefetch(base + 16 * k);
+      k = 2 * k + (base[k] < val);
+    }
+    // k encodes the path taken; strip the trailing right-turns plus one to reach the lower bound
+    k >>= __builtin_ffsll(~k);
+    return k != 0 && base[k] == val;
+  }
+  size_t size() const { return n; }
+};
+
+class BST
+{
+private:
+  Node *root;
+  size_t count;
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  BST() : root(nullptr), count(0) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+    count++;
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  // Snapshot of the current keys as an immutable, cache-friendly index
+  EytzingerIndex freeze() const
+  {
+    vector<int> sorted;
+    sorted.reserve(count);
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      sorted.push_back(curr->data);
+      curr = curr->right;
+    }
+    return EytzingerIndex(sorted);
+  }
+};
+
+template <typename Tree>
+static double lookupsPerSec(const Tree &tree, const vector<int> &queries, size_t &found)
+{
+  auto t0 = chrono::steady_clock::now();
+  found = 0;
+  for (int q : queries)
+    found += tree.search(q);
+  auto t1 = chrono::steady_clock::now();
+  return queries.size() / chrono::duration<double>(t1 - t0).count();
+}
+
+// Usage: ./bst_eytzinger_index [n] [queries]
+int main(int argc, char **argv)
+{
+  BST tree;
+  for (int val : {5, 3, 7, 2, 4, 6, 8})
+    tree.insert(val);
+  EytzingerIndex index = tree.freeze();
+  for (int key : {1, 4, 8, 9})
+    cout << "Search " << key << ": " << (index.search(key) ? "Found" : "Not Found") << endl;
+
+  size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+  size_t q = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+  mt19937 rng(42);
+  vector<int> keys(n);
+  BST big;
+  for (int &key : keys)
+  {
+    key = static_cast<int>(rng() >> 1);
+    big.insert(key); // Random order keeps the pointer tree shallow
+  }
+  EytzingerIndex frozen = big.freeze();
+
+  // Half the queries hit, half are random (almost always misses)
+  vector<int> queries(q);
+  for (size_t i = 0; i < q; i++)
+    queries[i] = i % 2 ? keys[rng() % n] : static_cast<int>(rng() >> 1);
+
+  size_t foundTree, foundIndex;
+  double treeRate = lookupsPerSec(big, queries, foundTree);
+  double indexRate = lookupsPerSec(frozen, queries, foundIndex);
+  cout << "\n=== Search benchmark: " << frozen.size() << " keys, " << q << " random queries ===" << endl;
+  cout << "pointer tree:    " << treeRate / 1e6 << " M lookups/sec (" << foundTree << " hits)" << endl;
+  cout << "Eytzinger index: " << indexRate / 1e6 << " M lookups/sec (" << foundIndex << " hits)" << endl;
+  return foundTree == foundIndex ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+// bst_flat_file.cpp
+// Saves a Binary Search Tree into a position-independent flat file and maps it read-only with mmap, so a saved tree can be searched right away with no deserialization.
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+const uint32_t NIL = 0xFFFFFFFF; // "No child" index
+const uint32_t FLAT_VERSION = 1;
+const char FLAT_MAGIC[8] = {'B', 'S', 'T', 'F', 'L', 'A', 'T', '\0'};
+
+// A flat file is a checksummed header followed by nodes that link to each other by index. It is
+// written and mapped with POSIX calls, in the host byte order.
+struct FlatHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t count;    // Number of nodes that follow the header
+  uint32_t root;     // Index of the root node, NIL for an empty tree
+  uint32_t checksum; // FNV-1a over the node array
+};
+
+struct FlatNode
+{
+  int32_t data;
+  uint32_t left;
+  uint32_t right;
+};
+
+static uint32_t fnv1a(const void *bytes, size_t len)
+{
+  const unsigned char *p = static_cast<const unsigned char *>(bytes);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= p[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+  size_t count;
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  BST() : root(nullptr), count(0) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+    count++;
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  // Writes the tree in preorder, so every left child directly follows its parent in the file
+  void save(const string &path) const
+  {
+    if (count >= NIL)
+      throw length_error("Tree too large for 32-bit node indices");
+    vector<FlatNode> nodes;
+    nodes.reserve(count);
+    // Each stack entry is a node plus the child link (2 * parent + side) that must receive its index
+    const size_t NO_PARENT = SIZE_MAX;
+    vector<pair<Node *, size_t>> stack;
+    if (root)
+      stack.push_back({root, NO_PARENT});
+    while (!stack.empty())
+    {
+      Node *node = stack.back().first;
+      size_t parentSlot = stack.back().second;
+      stack.pop_back();
+      uint32_t index = static_cast<uint32_t>(nodes.size());
+      if (parentSlot != NO_PARENT)
+      {
+        FlatNode &parent = nodes[parentSlot / 2];
+        (parentSlot % 2 ? parent.right : parent.left) = index;
+      }
+      nodes.push_back({node->data, NIL, NIL});
+      if (node->right)
+        stack.push_back({node->right, 2 * size_t(index) + 1});
+      if (node->left)
+        stack.push_back({node->left, 2 * size_t(index)});
+    }
+
+    FlatHeader header;
+    memcpy(header.magic, FLAT_MAGIC, sizeof(FLAT_MAGIC));
+    header.version = FLAT_VERSION;
+    header.count = static_cast<uint32_t>(nodes.size());
+    header.root = nodes.empty() ? NIL : 0;
+    header.checksum = fnv1a(nodes.data(), nodes.size() * sizeof(FlatNode));
+
+    ofstream out(path, ios::binary | ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(nodes.data()), nodes.size() * sizeof(FlatNode));
+    if (!out)
+      throw runtime_error("Failed to write " + path);
+  }
+};
+
+// Read-only tree backed directly by a mapped flat file
+class MappedBST
+{
+private:
+  void *base;
+  size_t length;
+  const FlatHeader *header;
+  const FlatNode *nodes;
+
+public:
+  // Validates the header and bounds; verifying the checksum reads every page, so it can be skipped
+  explicit MappedBST(const string &path, bool verifyChecksum = true) : base(MAP_FAILED), length(0)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw runtime_error("Cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(FlatHeader))
+    {
+      close(fd);
+      throw runtime_error("File too small to hold a header: " + path);
+    }
+    length = st.st_size;
+    base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+      throw runtime_error("mmap failed for " + path);
+
+    header = static_cast<const FlatHeader *>(base);
+    nodes = reinterpret_cast<const FlatNode *>(header + 1);
+    const char *error = nullptr;
+    if (memcmp(header->magic, FLAT_MAGIC, sizeof(FLAT_MAGIC)) != 0)
+      error = "Bad magic";
+    else if (header->version != FLAT_VERSION)
+      error = "Unsupported version";
+    else if (length != sizeof(FlatHeader) + size_t(header->count) * sizeof(FlatNode))
+      error = "Length does not match node count";
+    else if (header->root != NIL && header->root >= header->count)
+      error = "Root index out of range";
+    else if (verifyChecksum && fnv1a(nodes, size_t(header->count) * sizeof(FlatNode)) != header->checksum)
+      error = "Checksum mismatch";
+    if (error)
+    {
+      munmap(base, length);
+      throw runtime_error(string(error) + " in " + path);
+    }
+  }
+  ~MappedBST() { munmap(base, length); }
+  MappedBST(const MappedBST &) = delete;
+  MappedBST &operator=(const MappedBST &) = delete;
+
+  bool search(int val) const
+  {
+    uint32_t count = header->count;
+    uint32_t i = header->root;
+    // Child indices are bounds-checked, and the step limit stops cycles in a corrupt unverified file
+    for (uint32_t steps = 0; i < count && steps < count; steps++)
+    {
+      const FlatNode &node = nodes[i];
+      if (node.data == val)
+        return true;
+      i = val < node.data ? node.left : node.right;
+    }
+    return false;
+  }
+  size_t size() const { return header->count; }
+};
+
+// Usage: ./bst_flat_file [n]
+int main(int argc, char **argv)
+{
+  const string flatPath = "bst_flat_file.bin", textPath = "bst_flat_file_keys.txt";
+  {
+    BST tree;
+    for (int val : {5, 3, 7, 2, 4, 6, 8})
+      tree.insert(val);
+    tree.save(flatPath);
+    MappedBST mapped(flatPath);
+    for (int key : {4, 9})
+      cout << "Search " << key << " in mapped file: " << (mapped.search(key) ? "Found" : "Not Found") << endl;
+  }
+
+  int n = argc > 1 ? atoi(argv[1]) : 2000000;
+  mt19937 rng(42);
+  vector<int> keys(n);
+  {
+    BST tree;
+    ofstream text(textPath);
+    for (int &key : keys)
+    {
+      key = static_cast<int>(rng());
+      tree.insert(key);
+      text << key << '\n';
+    }
+    tree.save(flatPath);
+  }
+
+  using Clock = chrono::steady_clock;
+  auto t0 = Clock::now();
+  BST rebuilt;
+  {
+    ifstream text(textPath);
+    int key;
+    while (text >> key)
+      rebuilt.insert(key);
+  }
+  auto t1 = Clock::now();
+  MappedBST verified(flatPath);
+  auto t2 = Clock::now();
+  MappedBST unverified(flatPath, false);
+  auto t3 = Clock::now();
+  size_t hits = 0;
+  for (int i = 0; i < 1000; i++)
+    hits += unverified.search(keys[rng() % n]);
+  auto t4 = Clock::now();
+
+  cout << "\n=== Startup with " << verified.size() << " keys ===" << endl;
+  cout << "re-insert from text:      " << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+  cout << "mmap + checksum verify:   " << chrono::duration<double, milli>(t2 - t1).count() << " ms" << endl;
+  cout << "mmap, header checks only: " << chrono::duration<double, milli>(t3 - t2).count() << " ms" << endl;
+  cout << "first 1000 lookups on the cold mapping: " << chrono::duration<double, milli>(t4 - t3).count()
+       << " ms (" << hits << " hits)" << endl;
+  remove(flatPath.c_str());
+  remove(textPath.c_str());
+  return 0;
+}
@@ -1,31 +1,81 @@
 // bst_min_max.cpp
-// Demonstrates finding the minimum and maximum elements in a Binary Search Tree (BST) using leftmost and rightmost traversal.
+// Demonstrates finding the minimum and maximum elements in a Binary Search Tree (BST). Nodes are augmented with subtree sizes and the tree caches pointers to its leftmost and rightmost nodes, so min/max are O(1) and rank (keys below a value) and select (k-th smallest key) take one root-to-leaf walk.
 #include <iostream>
+#include <stdexcept>
 using namespace std;
 
 class Node
 {
 public:
   int data;
+  int size; // Number of nodes in the subtree rooted here
   Node *left, *right;
-  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+  Node(int val) : data(val), size(1), left(nullptr), right(nullptr) {}
 };
 
 class BST
 {
 private:
   Node *root;
-  void insert(Node *&node, int val)
+  Node *minNode, *maxNode; // Cached leftmost and rightmost nodes
+
+  static int size(Node *node) { return node ? node->size : 0; }
+
+  // Returns the new node, or nullptr if val was already present
+  Node *insert(Node *&node, int val)
   {
     if (!node)
     {
       node = new Node(val);
-      return;
+      return node;
     }
+    Node *added = nullptr;
+    if (val < node->data)
+      added = insert(node->left, val);
+    else if (val > node->data)
+      added = insert(node->right, val);
+    if (added)
+      node->size++;
+    return added;
+  }
+  bool erase(Node *&node, int val)
+  {
+    if (!node)
+      return false;
+    bool removed;
     if (val < node->data)
-      insert(node->left, val);
+      removed = erase(node->left, val);
     else if (val > node->data)
-      insert(node->right, val);
+      removed = erase(node->right, val);
+    else if (node->left && node->right)
+    {
+      // Two children: take the inorder successor's value and remove the successor instead
+      Node *succ = node->right;
+      while (succ->left)
+        succ = succ->left;
+      node->data = succ->data;
+      removed = erase(node->right, succ->data);
+    }
+    else
+    {
+      Node *child = node->left ? node->left : node->right;
+      delete node;
+      node = child;
+      return true;
+    }
+    if (removed)
+      node->size--;
+    return removed;
+  }
+  void refreshMinMax()
+  {
+    minNode = maxNode = root;
+    if (!root)
+      return;
+    while (minNode->left)
+      minNode = minNode->left;
+    while (maxNode->right)
+      maxNode = maxNode->right;
   }
   void destroy(Node *node)
   {
@@ -37,26 +87,78 @@ private:
   }
 
 public:
-  BST() : root(nullptr) {}
+  BST() : root(nullptr), minNode(nullptr), maxNode(nullptr) {}
   ~BST() { destroy(root); }
-  void insert(int val) { insert(root, val); }
-  int findMin()
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
   {
-    if (!root)
+    Node *added = insert(root, val);
+    if (!added)
+      return;
+    if (!minNode || val < minNode->data)
+      minNode = added;
+    if (!maxNode || val > maxNode->data)
+      maxNode = added;
+  }
+  bool erase(int val)
+  {
+    if (!erase(root, val))
+      return false;
+    // Node contents may have moved during a two-child erase, so re-walk both spines (O(height))
+    refreshMinMax();
+    return true;
+  }
+  int count() const { return size(root); }
+  int findMin() const
+  {
+    if (!minNode)
       throw runtime_error("Tree is empty");
-    Node *curr = root;
-    while (curr->left)
-      curr = curr->left;
-    return curr->data;
+    return minNode->data;
   }
-  int findMax()
+  int findMax() const
   {
-    if (!root)
+    if (!maxNode)
       throw runtime_error("Tree is empty");
+    return maxNode->data;
+  }
+  // Number of keys strictly less than val
+  int rank(int val) const
+  {
+    int r = 0;
+    Node *curr = root;
+    while (curr)
+    {
+      if (val <= curr->data)
+        curr = curr->left;
+      else
+      {
+        r += size(curr->left) + 1;
+        curr = curr->right;
+      }
+    }
+    return r;
+  }
+  // k-th smallest key, counting from 1
+  int select(int k) const
+  {
+    if (k < 1 || k > size(root))
+      throw out_of_range("Rank out of range");
     Node *curr = root;
-    while (curr->right)
-      curr = curr->right;
-    return curr->data;
+    while (true)
+    {
+      int leftSize = size(curr->left);
+      if (k == leftSize + 1)
+        return curr->data;
+      if (k <= leftSize)
+        curr = curr->left;
+      else
+      {
+        k -= leftSize + 1;
+        curr = curr->right;
+      }
+    }
   }
 };
 
@@ -73,5 +175,23 @@ int main()
 
   cout << "Min element: " << tree.findMin() << endl;
   cout << "Max element: " << tree.findMax() << endl;
+
+  cout << "3rd smallest: " << tree.select(3) << endl;
+  cout << "Median: " << tree.select((tree.count() + 1) / 2) << endl;
+  cout << "Rank of 6 (keys below it): " << tree.rank(6) << endl;
+
+  tree.erase(2);
+  tree.erase(8);
+  tree.erase(5);
+  cout << "After erasing 2, 8 and 5 -> min: " << tree.findMin() << ", max: " << tree.findMax()
+       << ", count: " << tree.count() << endl;
+  try
+  {
+    tree.select(10);
+  }
+  catch (const exception &e)
+  {
+    cout << "select(10): " << e.what() << endl;
+  }
   return 0;
 }
@@ -0,0 +1,189 @@
+// bst_multiset.cpp
+// Implements a multiset on a Binary Search Tree: instead of dropping duplicates, every node stores how many times its key occurs, and erase decrements that count (the node is removed when it reaches zero). Nodes also store the total count of their subtree, so count(key) and rangeCount(lo, hi) take one or two root-to-leaf walks.
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  long count; // Occurrences of data
+  long total; // Sum of count over the subtree rooted here
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), count(1), total(1), left(nullptr), right(nullptr) {}
+};
+
+class MultiBST
+{
+private:
+  Node *root;
+  size_t distinctKeys;
+
+  static long total(Node *node) { return node ? node->total : 0; }
+
+  // Occurrences of keys strictly less than val
+  long countLess(int val) const
+  {
+    long r = 0;
+    Node *curr = root;
+    while (curr)
+    {
+      if (val <= curr->data)
+        curr = curr->left;
+      else
+      {
+        r += total(curr->left) + curr->count;
+        curr = curr->right;
+      }
+    }
+    return r;
+  }
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  MultiBST() : root(nullptr), distinctKeys(0) {}
+  ~MultiBST() { destroy(root); }
+  MultiBST(const MultiBST &) = delete;
+  MultiBST &operator=(const MultiBST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      Node *node = *link;
+      node->total++;
+      if (val == node->data)
+      {
+        node->count++;
+        return;
+      }
+      link = val < node->data ? &node->left : &node->right;
+    }
+    *link = new Node(val);
+    distinctKeys++;
+  }
+  // Removes one occurrence of val; returns false if val is not present
+  bool erase(int val)
+  {
+    if (count(val) == 0)
+      return false;
+    Node **link = &root;
+    while ((*link)->data != val)
+    {
+      (*link)->total--;
+      link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    Node *node = *link;
+    node->total--;
+    if (--node->count > 0)
+      return true;
+
+    if (node->left && node->right)
+    {
+      // Move the inorder successor's key and count into node, then unlink the successor
+      Node **succLink = &node->right;
+      while ((*succLink)->left)
+        succLink = &(*succLink)->left;
+      Node *succ = *succLink;
+      // Every node between node and the successor loses the successor's occurrences
+      for (Node *curr = node->right; curr != succ; curr = curr->left)
+        curr->total -= succ->count;
+      node->data = succ->data;
+      node->count = succ->count;
+      *succLink = succ->right;
+      delete succ;
+    }
+    else
+    {
+      *link = node->left ? node->left : node->right;
+      delete node;
+    }
+    distinctKeys--;
+    return true;
+  }
+  long count(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return curr->count;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return 0;
+  }
+  // Occurrences of keys in [lo, hi)
+  long rangeCount(int lo, int hi) const { return lo < hi ? countLess(hi) - countLess(lo) : 0; }
+  long size() const { return total(root); }
+  size_t distinct() const { return distinctKeys; }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << "x" << curr->count << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+};
+
+// Usage: ./bst_multiset [stream_length] [distinct_keys]
+int main(int argc, char **argv)
+{
+  MultiBST tree;
+  for (int val : {5, 3, 7, 3, 5, 5, 8, 2})
+    tree.insert(val);
+  cout << "Inorder (key x count): ";
+  tree.inorder();
+  cout << "count(5): " << tree.count(5) << ", rangeCount(3, 7): " << tree.rangeCount(3, 7) << endl;
+  tree.erase(5);
+  tree.erase(3);
+  tree.erase(3);
+  cout << "After erasing 5, 3, 3: ";
+  tree.inorder();
+  cout << "size: " << tree.size() << ", distinct: " << tree.distinct() << endl;
+
+  // A duplicate-heavy stream needs one node per distinct key
+  long n = argc > 1 ? atol(argv[1]) : 5000000;
+  int distinct = argc > 2 ? atoi(argv[2]) : 10000;
+  MultiBST stream;
+  mt19937 rng(42);
+  for (long i = 0; i < n; i++)
+    stream.insert(static_cast<int>(rng() % distinct));
+  cout << "\nStream of " << stream.size() << " values -> " << stream.distinct() << " nodes ("
+       << stream.distinct() * sizeof(Node) / 1024 << " KB), rangeCount(0, " << distinct / 2 << "): "
+       << stream.rangeCount(0, distinct / 2) << endl;
+  return 0;
+}
@@ -0,0 +1,269 @@
+// bst_node_pool.cpp
+// Implements a Binary Search Tree whose nodes come from an arena-backed node pool: nodes are bump-allocated from large slabs, erased nodes go onto a free list for reuse, and the destructor releases every slab at once instead of deleting node by node. main() compares allocation rate and resident memory against the plain new/delete tree.
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <new>
+#include <type_traits>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/resource.h>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+// Plain allocator: one new/delete per node (what binary_search_tree.cpp does)
+class HeapAllocator
+{
+public:
+  Node *allocate(int val) { return new Node(val); }
+  void deallocate(Node *node) { delete node; }
+  static constexpr bool releasesInBulk = false;
+  void releaseAll() {}
+};
+
+// Arena allocator: bump allocation inside slabs, freed nodes are chained through their left pointer
+class NodePool
+{
+private:
+  vector<Node *> slabs;
+  size_t slabSize; // Nodes per slab
+  size_t used;     // Nodes handed out from the current slab
+  Node *freeList;
+
+public:
+  explicit NodePool(size_t nodesPerSlab = 1 << 16) : slabSize(nodesPerSlab), used(nodesPerSlab), freeList(nullptr) {}
+  ~NodePool() { releaseAll(); }
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  Node *allocate(int val)
+  {
+    if (freeList)
+    {
+      Node *node = freeList;
+      freeList = freeList->left;
+      return new (node) Node(val);
+    }
+    if (used == slabSize)
+    {
+      slabs.push_back(static_cast<Node *>(::operator new(slabSize * sizeof(Node))));
+      used = 0;
+    }
+    return new (slabs.back() + used++) Node(val);
+  }
+  void deallocate(Node *node)
+  {
+    node->left = freeList;
+    freeList = node;
+  }
+  static constexpr bool releasesInBulk = true;
+  // Node is trivially destructible, so dropping the slabs frees the whole tree
+  static_assert(is_trivially_destructible<Node>::value, "releaseAll() skips node destructors");
+  void releaseAll()
+  {
+    for (Node *slab : slabs)
+      ::operator delete(slab);
+    slabs.clear();
+    used = slabSize;
+    freeList = nullptr;
+  }
+  size_t slabCount() const { return slabs.size(); }
+};
+
+template <typename Allocator>
+class BST
+{
+private:
+  Node *root;
+  Allocator alloc;
+
+  void destroy(Node *node)
+  {
+    // Iterative teardown: rotate left children up so the tree becomes a right spine
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        alloc.deallocate(node);
+        node = next;
+      }
+    }
+  }
+
+public:
+  BST() : root(nullptr) {}
+  ~BST()
+  {
+    if constexpr (Allocator::releasesInBulk)
+      alloc.releaseAll();
+    else
+      destroy(root);
+  }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = alloc.allocate(val);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (val == curr->data)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  // Removes val if present; the node is handed back to the allocator
+  bool erase(int val)
+  {
+    Node **link = &root;
+    while (*link && (*link)->data != val)
+      link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    Node *node = *link;
+    if (!node)
+      return false;
+    if (node->left && node->right)
+    {
+      // Replace the value with the inorder successor and unlink the successor instead
+      Node **succ = &node->right;
+      while ((*succ)->left)
+        succ = &(*succ)->left;
+      node->data = (*succ)->data;
+      link = succ;
+      node = *succ;
+    }
+    *link = node->left ? node->left : node->right;
+    alloc.deallocate(node);
+    return true;
+  }
+  void clear()
+  {
+    if constexpr (Allocator::releasesInBulk)
+      alloc.releaseAll();
+    else
+      destroy(root);
+    root = nullptr;
+  }
+  const Allocator &allocator() const { return alloc; }
+};
+
+// Current resident set size in KB; falls back to the peak RSS where /proc is unavailable
+static long residentKB()
+{
+  ifstream statm("/proc/self/statm");
+  long pages, resident;
+  if (statm >> pages >> resident)
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Allocator alone: allocate n nodes, free every other one, allocate n / 2 again, then release everything
+template <typename Allocator>
+static void allocatorBenchmark(const char *name, size_t n)
+{
+  using Clock = chrono::steady_clock;
+  vector<Node *> nodes(n);
+  Allocator alloc;
+  auto t0 = Clock::now();
+  for (size_t i = 0; i < n; i++)
+    nodes[i] = alloc.allocate(int(i));
+  for (size_t i = 0; i < n; i += 2)
+    alloc.deallocate(nodes[i]);
+  for (size_t i = 0; i < n; i += 2)
+    nodes[i] = alloc.allocate(int(i));
+  if constexpr (Allocator::releasesInBulk)
+    alloc.releaseAll();
+  else
+    for (Node *node : nodes)
+      alloc.deallocate(node);
+  auto t1 = Clock::now();
+
+  size_t ops = n + n / 2 + n / 2 + n; // Allocations plus frees
+  cout << name << ": " << ops / chrono::duration<double>(t1 - t0).count() / 1e6 << " M allocator ops/sec" << endl;
+}
+
+// Whole tree: random inserts (dominated by the descent's cache misses), resident memory and teardown
+template <typename Allocator>
+static void benchmark(const char *name, const vector<int> &keys)
+{
+  using Clock = chrono::steady_clock;
+  long before = residentKB();
+  auto *tree = new BST<Allocator>();
+  auto t0 = Clock::now();
+  for (int key : keys)
+    tree->insert(key);
+  auto t1 = Clock::now();
+  long after = residentKB();
+  delete tree;
+  auto t2 = Clock::now();
+
+  double buildSec = chrono::duration<double>(t1 - t0).count();
+  double freeMs = chrono::duration<double, milli>(t2 - t1).count();
+  cout << name << ": " << keys.size() / buildSec / 1e6 << " M inserts/sec, RSS +"
+       << (after - before) / 1024 << " MB, teardown " << freeMs << " ms" << endl;
+}
+
+// Usage: ./bst_node_pool [n]
+int main(int argc, char **argv)
+{
+  BST<NodePool> tree;
+  for (int val : {5, 3, 7, 2, 4, 6, 8})
+    tree.insert(val);
+  tree.erase(3);
+  tree.erase(7);
+  tree.insert(9); // Reuses a node from the free list
+  cout << "Search 3: " << (tree.search(3) ? "Found" : "Not Found") << endl;
+  cout << "Search 9: " << (tree.search(9) ? "Found" : "Not Found") << endl;
+  cout << "Slabs in use: " << tree.allocator().slabCount() << endl;
+
+  int n = argc > 1 ? atoi(argv[1]) : 5000000;
+  vector<int> keys(n);
+  mt19937 rng(42);
+  for (int &key : keys)
+    key = static_cast<int>(rng());
+
+  // The pool runs first: its slabs are returned to the OS on release, keeping the heap measurement clean
+  cout << "\n=== Random insert benchmark, n=" << n << " ===" << endl;
+  benchmark<NodePool>("node pool", keys);
+  benchmark<HeapAllocator>("new/delete", keys);
+
+  // Runs last: freed heap memory stays resident and would hide the RSS growth measured above
+  cout << "\n=== Allocation benchmark, n=" << n << " ===" << endl;
+  allocatorBenchmark<NodePool>("node pool", n);
+  allocatorBenchmark<HeapAllocator>("new/delete", n);
+  return 0;
+}
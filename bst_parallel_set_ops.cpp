@@ -0,0 +1,451 @@
+// bst_parallel_set_ops.cpp
+// Implements join-based union, intersection and difference of two treap Binary Search Trees, with the recursion run in parallel on a work-stealing task pool. Build with: g++ -O2 -pthread bst_parallel_set_ops.cpp
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  uint32_t priority;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), priority(hashKey(val)), left(nullptr), right(nullptr) {}
+
+  // Deterministic priority (murmur3 finalizer), so equal key sets always form the same treap
+  static uint32_t hashKey(int val)
+  {
+    uint32_t h = static_cast<uint32_t>(val);
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+  }
+};
+
+// Fixed set of workers, each with its own deque of forked tasks. A worker pushes and pops at the
+// back of its own deque and, when that is empty, steals from the front of another's, so the oldest
+// and largest pending subproblems are the ones that move between threads.
+class TaskPool
+{
+private:
+  struct Task
+  {
+    function<void()> run;
+    atomic<bool> done{false};
+  };
+  struct alignas(64) Queue
+  {
+    mutex lock;
+    deque<Task *> tasks;
+  };
+  vector<Queue> queues; // queues[0] belongs to the thread that created the pool
+  vector<thread> workers;
+  atomic<bool> stopping;
+  static inline thread_local size_t self = 0; // Index of the calling thread's queue
+
+  void push(Task *task)
+  {
+    lock_guard<mutex> guard(queues[self].lock);
+    queues[self].tasks.push_back(task);
+  }
+  Task *pop()
+  {
+    lock_guard<mutex> guard(queues[self].lock);
+    if (queues[self].tasks.empty())
+      return nullptr;
+    Task *task = queues[self].tasks.back();
+    queues[self].tasks.pop_back();
+    return task;
+  }
+  Task *steal()
+  {
+    for (size_t i = 1; i < queues.size(); i++)
+    {
+      Queue &victim = queues[(self + i) % queues.size()];
+      lock_guard<mutex> guard(victim.lock);
+      if (!victim.tasks.empty())
+      {
+        Task *task = victim.tasks.front();
+        victim.tasks.pop_front();
+        return task;
+      }
+    }
+    return nullptr;
+  }
+  // Runs one pending task, own first; returns false if there was none anywhere
+  bool runOne()
+  {
+    Task *task = pop();
+    if (!task)
+      task = steal();
+    if (!task)
+      return false;
+    task->run();
+    task->done.store(true, memory_order_release);
+    return true;
+  }
+
+public:
+  // The creating thread counts as one of the workers and must be the one that calls forkJoin
+  explicit TaskPool(int threads) : queues(threads), stopping(false)
+  {
+    self = 0;
+    for (int i = 1; i < threads; i++)
+      workers.emplace_back([this, i]()
+                           {
+                             self = i;
+                             while (!stopping.load(memory_order_acquire))
+                               if (!runOne())
+                                 this_thread::yield();
+                           });
+  }
+  ~TaskPool()
+  {
+    stopping.store(true, memory_order_release);
+    for (thread &worker : workers)
+      worker.join();
+  }
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  // Offers leftTask to thieves, runs rightTask, then runs pending tasks until leftTask is done
+  template <typename L, typename R>
+  void forkJoin(const L &leftTask, const R &rightTask)
+  {
+    Task left;
+    left.run = leftTask;
+    push(&left);
+    rightTask();
+    while (!left.done.load(memory_order_acquire))
+      if (!runOne())
+        this_thread::yield();
+  }
+};
+
+class BST
+{
+private:
+  Node *root;
+
+  explicit BST(Node *r) : root(r) {}
+
+  // Splits node into keys < key and keys > key; returns the node holding key (detached), if any
+  static Node *split(Node *node, int key, Node *&less, Node *&greater)
+  {
+    if (!node)
+    {
+      less = greater = nullptr;
+      return nullptr;
+    }
+    Node *found;
+    if (key < node->data)
+    {
+      found = split(node->left, key, less, node->left);
+      greater = node;
+    }
+    else if (key > node->data)
+    {
+      found = split(node->right, key, node->right, greater);
+      less = node;
+    }
+    else
+    {
+      less = node->left;
+      greater = node->right;
+      node->left = node->right = nullptr;
+      found = node;
+    }
+    return found;
+  }
+  // Concatenates two treaps where all keys of a are below all keys of b
+  static Node *join(Node *a, Node *b)
+  {
+    if (!a)
+      return b;
+    if (!b)
+      return a;
+    if (a->priority > b->priority)
+    {
+      a->right = join(a->right, b);
+      return a;
+    }
+    b->left = join(a, b->left);
+    return b;
+  }
+  // Joins a and b with mid as the separating root, restoring heap order on priorities
+  static Node *join3(Node *a, Node *mid, Node *b)
+  {
+    mid->left = mid->right = nullptr;
+    if ((!a || mid->priority >= a->priority) && (!b || mid->priority >= b->priority))
+    {
+      mid->left = a;
+      mid->right = b;
+      return mid;
+    }
+    return join(join(a, mid), b);
+  }
+  static void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+  // Forks the two recursive calls onto the pool while depth > 0, runs them sequentially below
+  template <typename L, typename R>
+  static void forkJoin(TaskPool *pool, int depth, const L &leftTask, const R &rightTask)
+  {
+    if (pool && depth > 0)
+      pool->forkJoin(leftTask, rightTask);
+    else
+    {
+      leftTask();
+      rightTask();
+    }
+  }
+
+  // All three operations consume both inputs; nodes not in the result are deleted
+  static Node *unite(Node *a, Node *b, TaskPool *pool, int depth)
+  {
+    if (!a)
+      return b;
+    if (!b)
+      return a;
+    if (a->priority < b->priority)
+      swap(a, b); // Root of the result is the higher-priority root
+    Node *less, *greater;
+    Node *dup = split(b, a->data, less, greater);
+    delete dup;
+    Node *l, *r;
+    auto leftTask = [&]()
+    { l = unite(a->left, less, pool, depth - 1); };
+    auto rightTask = [&]()
+    { r = unite(a->right, greater, pool, depth - 1); };
+    forkJoin(pool, depth, leftTask, rightTask);
+    return join3(l, a, r);
+  }
+  static Node *intersect(Node *a, Node *b, TaskPool *pool, int depth)
+  {
+    if (!a || !b)
+    {
+      destroy(a);
+      destroy(b);
+      return nullptr;
+    }
+    Node *less, *greater;
+    Node *match = split(b, a->data, less, greater);
+    Node *l, *r;
+    auto leftTask = [&]()
+    { l = intersect(a->left, less, pool, depth - 1); };
+    auto rightTask = [&]()
+    { r = intersect(a->right, greater, pool, depth - 1); };
+    forkJoin(pool, depth, leftTask, rightTask);
+    if (match)
+    {
+      delete match;
+      return join3(l, a, r);
+    }
+    delete a;
+    return join(l, r);
+  }
+  static Node *subtract(Node *a, Node *b, TaskPool *pool, int depth)
+  {
+    if (!a || !b)
+    {
+      destroy(b);
+      return a;
+    }
+    Node *less, *greater;
+    Node *match = split(b, a->data, less, greater);
+    Node *l, *r;
+    auto leftTask = [&]()
+    { l = subtract(a->left, less, pool, depth - 1); };
+    auto rightTask = [&]()
+    { r = subtract(a->right, greater, pool, depth - 1); };
+    forkJoin(pool, depth, leftTask, rightTask);
+    if (match)
+    {
+      delete match;
+      delete a;
+      return join(l, r);
+    }
+    return join3(l, a, r);
+  }
+
+  // Each root splits its range at a uniformly random rank, so equal-depth subproblems differ widely
+  // in size. Forking OVERSPLIT levels past one task per thread leaves about 2^OVERSPLIT tasks per
+  // worker, enough for stealing to even out the load.
+  static const int OVERSPLIT = 6;
+  static int depthFor(int threads)
+  {
+    if (threads <= 1)
+      return 0;
+    int depth = OVERSPLIT;
+    while ((1 << (depth - OVERSPLIT)) < threads)
+      depth++;
+    return depth;
+  }
+  template <typename Op>
+  static Node *runOn(int threads, Op op)
+  {
+    if (threads <= 1)
+      return op(nullptr, 0);
+    TaskPool pool(threads);
+    return op(&pool, depthFor(threads));
+  }
+
+public:
+  BST() : root(nullptr) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  BST(BST &&other) : root(other.root) { other.root = nullptr; }
+
+  void insert(int val)
+  {
+    Node *less, *greater;
+    Node *found = split(root, val, less, greater);
+    root = join3(less, found ? found : new Node(val), greater);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  size_t size() const
+  {
+    size_t count = 0;
+    vector<Node *> stack;
+    if (root)
+      stack.push_back(root);
+    while (!stack.empty())
+    {
+      Node *node = stack.back();
+      stack.pop_back();
+      count++;
+      if (node->left)
+        stack.push_back(node->left);
+      if (node->right)
+        stack.push_back(node->right);
+    }
+    return count;
+  }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+
+  // Set operations consume both trees; threads is the number of pool workers, the caller included
+  static BST setUnion(BST &&a, BST &&b, int threads = 1)
+  {
+    Node *r = runOn(threads, [&](TaskPool *pool, int depth)
+                    { return unite(a.root, b.root, pool, depth); });
+    a.root = b.root = nullptr;
+    return BST(r);
+  }
+  static BST setIntersection(BST &&a, BST &&b, int threads = 1)
+  {
+    Node *r = runOn(threads, [&](TaskPool *pool, int depth)
+                    { return intersect(a.root, b.root, pool, depth); });
+    a.root = b.root = nullptr;
+    return BST(r);
+  }
+  static BST setDifference(BST &&a, BST &&b, int threads = 1)
+  {
+    Node *r = runOn(threads, [&](TaskPool *pool, int depth)
+                    { return subtract(a.root, b.root, pool, depth); });
+    a.root = b.root = nullptr;
+    return BST(r);
+  }
+};
+
+static BST build(const vector<int> &keys)
+{
+  BST tree;
+  for (int key : keys)
+    tree.insert(key);
+  return tree;
+}
+
+// Usage: ./bst_parallel_set_ops [n] [max_threads]
+int main(int argc, char **argv)
+{
+  vector<int> x = {1, 3, 5, 7, 9, 11}, y = {3, 4, 5, 6, 7};
+  cout << "Union:        ";
+  BST::setUnion(build(x), build(y)).inorder();
+  cout << "Intersection: ";
+  BST::setIntersection(build(x), build(y)).inorder();
+  cout << "Difference:   ";
+  BST::setDifference(build(x), build(y)).inorder();
+
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int maxThreads = argc > 2 ? atoi(argv[2]) : 32;
+  mt19937 rng(42);
+  vector<int> keysA(n), keysB(n);
+  for (int i = 0; i < n; i++)
+  {
+    keysA[i] = static_cast<int>(rng() % (4u * n));
+    keysB[i] = static_cast<int>(rng() % (4u * n));
+  }
+
+  cout << "\n=== Intersection of two " << n << "-key sets, " << thread::hardware_concurrency() << " hardware threads ===" << endl;
+  double base = 0;
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    BST a = build(keysA), b = build(keysB);
+    auto t0 = chrono::steady_clock::now();
+    BST result = BST::setIntersection(move(a), move(b), threads);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    if (threads == 1)
+      base = ms;
+    cout << threads << " threads: " << ms << " ms, speedup " << base / ms << "x, " << result.size() << " common keys" << endl;
+  }
+  return 0;
+}
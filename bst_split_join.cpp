@@ -0,0 +1,291 @@
+// bst_split_join.cpp
+// Adds split, join and merge to a Binary Search Tree by relinking existing nodes instead of reinserting keys. split(key) cuts the tree into keys below key and keys >= key along one root-to-leaf path, join concatenates two trees whose key ranges do not overlap in O(height), and merge combines two arbitrary trees in O(n + m) by flattening both into sorted lists, merging them and rebuilding a balanced tree.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+
+  explicit BST(Node *r) : root(r) {}
+
+  // Flattens the tree into a sorted list linked through right pointers, counting the nodes
+  static Node *toList(Node *node, size_t &count)
+  {
+    Node *head = nullptr;
+    Node **tail = &head;
+    count = 0;
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left; // Rotate right until there is no left child
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        *tail = node;
+        tail = &node->right;
+        node = node->right;
+        count++;
+      }
+    }
+    return head;
+  }
+  // Consumes the first n nodes of a sorted list and returns them as a balanced tree
+  static Node *fromList(Node *&head, size_t n)
+  {
+    if (n == 0)
+      return nullptr;
+    Node *left = fromList(head, n / 2);
+    Node *node = head;
+    head = head->right;
+    node->left = left;
+    node->right = fromList(head, n - n / 2 - 1);
+    return node;
+  }
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  BST() : root(nullptr) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  BST(BST &&other) : root(other.root) { other.root = nullptr; }
+  BST &operator=(BST &&other)
+  {
+    if (this != &other)
+    {
+      destroy(root);
+      root = other.root;
+      other.root = nullptr;
+    }
+    return *this;
+  }
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  bool empty() const { return !root; }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+
+  // Moves every key >= key into the returned tree; this tree keeps the keys < key. O(height).
+  BST split(int key)
+  {
+    Node *less = nullptr, *greater = nullptr;
+    Node **lessLink = &less, **greaterLink = &greater;
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data < key)
+      {
+        // curr and its left subtree are below key; keep cutting in its right subtree
+        *lessLink = curr;
+        lessLink = &curr->right;
+        curr = curr->right;
+      }
+      else
+      {
+        *greaterLink = curr;
+        greaterLink = &curr->left;
+        curr = curr->left;
+      }
+    }
+    *lessLink = nullptr;
+    *greaterLink = nullptr;
+    root = less;
+    return BST(greater);
+  }
+
+  // Concatenates two trees where every key in left is smaller than every key in right. O(height of left).
+  static BST join(BST &&left, BST &&right)
+  {
+    if (!left.root)
+      return move(right);
+    if (!right.root)
+      return move(left);
+    // Detach the maximum of left and use it as the new root
+    Node **link = &left.root;
+    while ((*link)->right)
+      link = &(*link)->right;
+    Node *top = *link;
+    Node *rightMin = right.root;
+    while (rightMin->left)
+      rightMin = rightMin->left;
+    if (top->data >= rightMin->data)
+      throw invalid_argument("join: left keys must all be smaller than right keys");
+    *link = top->left;
+    top->left = left.root;
+    top->right = right.root;
+    left.root = right.root = nullptr;
+    return BST(top);
+  }
+
+  // Merges two arbitrary trees into one balanced tree in O(n + m); duplicate keys are dropped
+  static BST merge(BST &&a, BST &&b)
+  {
+    size_t na, nb;
+    Node *x = toList(a.root, na), *y = toList(b.root, nb);
+    a.root = b.root = nullptr;
+    Node *head = nullptr;
+    Node **tail = &head;
+    size_t count = 0;
+    while (x || y)
+    {
+      Node *next;
+      if (x && y && x->data == y->data)
+      {
+        Node *dup = y;
+        y = y->right;
+        delete dup;
+        continue;
+      }
+      if (!y || (x && x->data < y->data))
+      {
+        next = x;
+        x = x->right;
+      }
+      else
+      {
+        next = y;
+        y = y->right;
+      }
+      *tail = next;
+      tail = &next->right;
+      count++;
+    }
+    *tail = nullptr;
+    return BST(fromList(head, count));
+  }
+};
+
+// Usage: ./bst_split_join [n]
+int main(int argc, char **argv)
+{
+  BST tree;
+  for (int val : {5, 3, 7, 2, 4, 6, 8})
+    tree.insert(val);
+  BST high = tree.split(5);
+  cout << "split(5) low:  ";
+  tree.inorder();
+  cout << "split(5) high: ";
+  high.inorder();
+  BST joined = BST::join(move(tree), move(high));
+  cout << "join:          ";
+  joined.inorder();
+
+  BST other;
+  for (int val : {1, 4, 9, 10, 6})
+    other.insert(val);
+  BST merged = BST::merge(move(joined), move(other));
+  cout << "merge with {1, 4, 6, 9, 10}: ";
+  merged.inorder();
+
+  // Resharding: move the upper half of a large tree into another shard
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  vector<int> keys(n);
+  mt19937 rng(42);
+  for (int &key : keys)
+    key = static_cast<int>(rng() >> 1);
+  int pivot = 1 << 30;
+
+  using Clock = chrono::steady_clock;
+  BST shard;
+  for (int key : keys)
+    shard.insert(key);
+  auto t0 = Clock::now();
+  BST upper = shard.split(pivot);
+  auto t1 = Clock::now();
+  BST whole = BST::join(move(shard), move(upper));
+  auto t2 = Clock::now();
+  // What resharding costs today: reinsert every moved key into the other shard
+  BST reinserted;
+  for (int key : keys)
+    if (key >= pivot)
+      reinserted.insert(key);
+  auto t3 = Clock::now();
+  BST all = BST::merge(move(whole), move(reinserted));
+  auto t4 = Clock::now();
+
+  cout << "\n=== Resharding " << n << " keys ===" << endl;
+  cout << "split:            " << chrono::duration<double, micro>(t1 - t0).count() << " us" << endl;
+  cout << "join back:        " << chrono::duration<double, micro>(t2 - t1).count() << " us" << endl;
+  cout << "reinsert half:    " << chrono::duration<double, milli>(t3 - t2).count() << " ms" << endl;
+  cout << "merge two trees:  " << chrono::duration<double, milli>(t4 - t3).count() << " ms" << endl;
+  cout << "search " << keys[0] << " after merge: " << (all.search(keys[0]) ? "Found" : "Not Found") << endl;
+  return 0;
+}
@@ -0,0 +1,305 @@
+// bst_template.cpp
+// Implements a generic key/value Binary Search Tree, BST<Key, Value, Compare, Allocator>, that replaces the hand-copied int, 64-bit and string variants.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+using namespace std;
+
+template <typename C, typename = void>
+struct isTransparent : false_type
+{
+};
+template <typename C>
+struct isTransparent<C, void_t<typename C::is_transparent>> : true_type
+{
+};
+
+template <typename Key, typename Value, typename Compare = less<Key>, typename Allocator = allocator<pair<const Key, Value>>>
+class BST
+{
+private:
+  struct Node
+  {
+    pair<const Key, Value> entry; // Constructed in place, so Value may be move-only
+    Node *left;
+    Node *right;
+    template <typename... Args>
+    explicit Node(Args &&...args) : entry(forward<Args>(args)...), left(nullptr), right(nullptr) {}
+  };
+  // Nodes are allocated through Allocator rebound to the node type
+  using NodeAllocator = typename allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = allocator_traits<NodeAllocator>;
+
+  Node *root;
+  size_t count;
+  Compare comp;
+  NodeAllocator alloc;
+
+  template <typename... Args>
+  Node *createNode(Args &&...args)
+  {
+    Node *node = NodeTraits::allocate(alloc, 1);
+    try
+    {
+      NodeTraits::construct(alloc, node, forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      NodeTraits::deallocate(alloc, node, 1);
+      throw;
+    }
+    return node;
+  }
+  void destroyNode(Node *node)
+  {
+    NodeTraits::destroy(alloc, node);
+    NodeTraits::deallocate(alloc, node, 1);
+  }
+  // Returns the link where key is, or where it would be inserted
+  template <typename K>
+  Node **findLink(const K &key)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (comp(key, (*link)->entry.first))
+        link = &(*link)->left;
+      else if (comp((*link)->entry.first, key))
+        link = &(*link)->right;
+      else
+        break;
+    }
+    return link;
+  }
+  template <typename K>
+  Node *findNode(const K &key) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (comp(key, curr->entry.first))
+        curr = curr->left;
+      else if (comp(curr->entry.first, key))
+        curr = curr->right;
+      else
+        return curr;
+    }
+    return nullptr;
+  }
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        destroyNode(node);
+        node = next;
+      }
+    }
+  }
+
+public:
+  explicit BST(const Compare &c = Compare(), const Allocator &a = Allocator()) : root(nullptr), count(0), comp(c), alloc(a) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  BST(BST &&other) : root(other.root), count(other.count), comp(move(other.comp)), alloc(move(other.alloc))
+  {
+    other.root = nullptr;
+    other.count = 0;
+  }
+
+  // Builds the pair from args, then links it in; if the key is already present the new node is discarded.
+  // Returns the entry with that key and whether it was inserted.
+  template <typename... Args>
+  pair<pair<const Key, Value> *, bool> emplace(Args &&...args)
+  {
+    Node *node = createNode(forward<Args>(args)...);
+    Node **link = findLink(node->entry.first);
+    if (*link)
+    {
+      destroyNode(node);
+      return {&(*link)->entry, false};
+    }
+    *link = node;
+    count++;
+    return {&node->entry, true};
+  }
+  // Looks the key up first and only allocates if it is absent; args are left untouched otherwise.
+  // Without a transparent comparator a foreign key type is converted to Key once, up front,
+  // rather than at every comparison on the way down.
+  template <typename K, typename... Args>
+  pair<pair<const Key, Value> *, bool> tryEmplace(K &&key, Args &&...args)
+  {
+    if constexpr (!isTransparent<Compare>::value && !is_same<typename decay<K>::type, Key>::value)
+    {
+      Key converted(forward<K>(key));
+      return tryEmplace(move(converted), forward<Args>(args)...);
+    }
+    else
+    {
+      Node **link = findLink(key);
+      if (*link)
+        return {&(*link)->entry, false};
+      *link = createNode(piecewise_construct, forward_as_tuple(forward<K>(key)), forward_as_tuple(forward<Args>(args)...));
+      count++;
+      return {&(*link)->entry, true};
+    }
+  }
+  bool insert(const Key &key, Value value) { return tryEmplace(key, move(value)).second; }
+
+  // Lookup by Key, or by any type the comparator accepts when it declares is_transparent
+  Value *find(const Key &key)
+  {
+    Node *node = findNode(key);
+    return node ? &node->entry.second : nullptr;
+  }
+  const Value *find(const Key &key) const
+  {
+    Node *node = findNode(key);
+    return node ? &node->entry.second : nullptr;
+  }
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  Value *find(const K &key)
+  {
+    Node *node = findNode(key);
+    return node ? &node->entry.second : nullptr;
+  }
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  const Value *find(const K &key) const
+  {
+    Node *node = findNode(key);
+    return node ? &node->entry.second : nullptr;
+  }
+  bool search(const Key &key) const { return findNode(key) != nullptr; }
+  template <typename K, typename C = Compare, typename = typename C::is_transparent>
+  bool search(const K &key) const
+  {
+    return findNode(key) != nullptr;
+  }
+  size_t size() const { return count; }
+
+  // Calls f(key, value) for every entry in key order
+  template <typename F>
+  void inorder(F f) const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      f(curr->entry.first, curr->entry.second);
+      curr = curr->right;
+    }
+  }
+};
+
+// Standard allocator that counts the allocations made through it (shared by all rebound copies)
+static size_t allocations = 0;
+
+template <typename T>
+class CountingAllocator
+{
+public:
+  using value_type = T;
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &) {}
+  T *allocate(size_t n)
+  {
+    allocations++;
+    return allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) { allocator<T>().deallocate(p, n); }
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &) const { return true; }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &) const { return false; }
+};
+
+// Usage: ./bst_template [n] [lookups]
+int main(int argc, char **argv)
+{
+  // 64-bit keys with move-only values
+  BST<long long, unique_ptr<string>> owners;
+  owners.emplace(5000000000LL, make_unique<string>("five billion"));
+  owners.tryEmplace(42LL, make_unique<string>("forty-two"));
+  owners.insert(-7, make_unique<string>("minus seven"));
+  cout << "Inorder traversal: ";
+  owners.inorder([](long long key, const unique_ptr<string> &value)
+                 { cout << key << "=" << *value << " "; });
+  cout << endl;
+
+  // String keys looked up through string_view: less<> is transparent, so no temporary string is made
+  using StringTree = BST<string, int, less<>, CountingAllocator<pair<const string, int>>>;
+  StringTree words;
+  for (const char *word : {"pear", "apple", "a rather long key that does not fit in small-string storage", "fig"})
+    words.tryEmplace(string(word), int(words.size()));
+  size_t before = allocations;
+  string_view probe = "a rather long key that does not fit in small-string storage";
+  const int *id = words.find(probe);
+  cout << "find(string_view): " << (id ? to_string(*id) : "Not Found") << ", allocations during lookup: "
+       << allocations - before << endl;
+
+  int n = argc > 1 ? atoi(argv[1]) : 10000;
+  int q = argc > 2 ? atoi(argv[2]) : 2000000;
+  mt19937 rng(42);
+  vector<string> keys(n);
+  BST<string, int, less<>> transparent;
+  BST<string, int> plain;
+  for (int i = 0; i < n; i++)
+  {
+    keys[i] = "customer/" + to_string(rng()) + "/orders/" + to_string(i); // Longer than the SSO buffer
+    transparent.tryEmplace(keys[i], i);
+    plain.tryEmplace(keys[i], i);
+  }
+  // The queries arrive as views into a request buffer
+  string buffer;
+  vector<pair<size_t, size_t>> spans(q);
+  for (int i = 0; i < q; i++)
+  {
+    const string &key = keys[rng() % n];
+    spans[i] = {buffer.size(), key.size()};
+    buffer += key;
+  }
+
+  using Clock = chrono::steady_clock;
+  long long sumView = 0, sumCopy = 0;
+  for (int i = 0; i < n; i++) // Warm both trees up so neither pass pays the cold misses
+    sumView += *transparent.find(keys[i]) - *plain.find(keys[i]);
+  auto t0 = Clock::now();
+  for (auto [offset, length] : spans)
+    sumView += *transparent.find(string_view(buffer).substr(offset, length));
+  auto t1 = Clock::now();
+  for (auto [offset, length] : spans)
+    sumCopy += *plain.find(string(buffer, offset, length));
+  auto t2 = Clock::now();
+
+  cout << "\n=== " << q << " lookups against " << n << " string keys ===" << endl;
+  cout << "less<> + string_view:      " << q / chrono::duration<double>(t1 - t0).count() / 1e6 << " M lookups/sec" << endl;
+  cout << "less<string> + temporary:  " << q / chrono::duration<double>(t2 - t1).count() / 1e6 << " M lookups/sec" << endl;
+  return sumView == sumCopy ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// concurrent_bst.cpp
+// Implements a Binary Search Tree shared between threads: search never takes a lock (child links are atomics read with acquire ordering) and insert publishes a new leaf with a compare-and-swap on the single empty link it attaches to, so writers only contend when they race for the same link. main() measures search throughput from 1 to 64 threads against a tree guarded by one global mutex. Build with: g++ -O2 -pthread concurrent_bst.cpp
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  const int data;
+  atomic<Node *> left;
+  atomic<Node *> right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+// Nodes are never unlinked while the tree is shared, so a reader can never reach freed memory and
+// no epoch or hazard-pointer reclamation is needed; everything is freed in the destructor.
+class ConcurrentBST
+{
+private:
+  atomic<Node *> root;
+
+public:
+  ConcurrentBST() : root(nullptr) {}
+  ~ConcurrentBST()
+  {
+    Node *node = root.load(memory_order_relaxed);
+    while (node)
+    {
+      Node *l = node->left.load(memory_order_relaxed);
+      if (l)
+      {
+        node->left.store(l->right.load(memory_order_relaxed), memory_order_relaxed);
+        l->right.store(node, memory_order_relaxed);
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right.load(memory_order_relaxed);
+        delete node;
+        node = next;
+      }
+    }
+  }
+  ConcurrentBST(const ConcurrentBST &) = delete;
+  ConcurrentBST &operator=(const ConcurrentBST &) = delete;
+
+  // Returns false if val was already present
+  bool insert(int val)
+  {
+    Node *fresh = nullptr;
+    atomic<Node *> *link = &root;
+    while (true)
+    {
+      Node *curr = link->load(memory_order_acquire);
+      if (!curr)
+      {
+        if (!fresh)
+          fresh = new Node(val);
+        // Release ordering publishes the fully constructed node to readers
+        if (link->compare_exchange_weak(curr, fresh, memory_order_release, memory_order_acquire))
+          return true;
+        continue; // Another writer filled this link first: re-read it and keep descending
+      }
+      if (val == curr->data)
+      {
+        delete fresh;
+        return false;
+      }
+      link = val < curr->data ? &curr->left : &curr->right;
+    }
+  }
+  bool search(int val) const
+  {
+    Node *curr = root.load(memory_order_acquire);
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = (val < curr->data ? curr->left : curr->right).load(memory_order_acquire);
+    }
+    return false;
+  }
+};
+
+// Baseline: plain BST behind one mutex
+class LockedBST
+{
+private:
+  struct PlainNode
+  {
+    int data;
+    PlainNode *left, *right;
+  };
+  PlainNode *root;
+  mutable mutex lock;
+
+public:
+  LockedBST() : root(nullptr) {}
+  ~LockedBST()
+  {
+    PlainNode *node = root;
+    while (node)
+    {
+      if (node->left)
+      {
+        PlainNode *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        PlainNode *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+  bool insert(int val)
+  {
+    lock_guard<mutex> guard(lock);
+    PlainNode **link = &root;
+    while (*link)
+    {
+      if (val == (*link)->data)
+        return false;
+      link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    *link = new PlainNode{val, nullptr, nullptr};
+    return true;
+  }
+  bool search(int val) const
+  {
+    lock_guard<mutex> guard(lock);
+    PlainNode *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+};
+
+// Runs `threads` workers doing `perThread` random lookups each; returns total lookups/sec
+template <typename Tree>
+static double searchThroughput(const Tree &tree, int threads, int perThread, int keyRange)
+{
+  vector<thread> workers;
+  atomic<long> hits(0);
+  auto t0 = chrono::steady_clock::now();
+  for (int t = 0; t < threads; t++)
+  {
+    workers.emplace_back([&, t]()
+                         {
+      mt19937 rng(t + 1);
+      long local = 0;
+      for (int i = 0; i < perThread; i++)
+        local += tree.search(static_cast<int>(rng() % keyRange));
+      hits += local; });
+  }
+  for (thread &w : workers)
+    w.join();
+  auto t1 = chrono::steady_clock::now();
+  return double(threads) * perThread / chrono::duration<double>(t1 - t0).count();
+}
+
+// Usage: ./concurrent_bst [n] [lookups_per_thread]
+int main(int argc, char **argv)
+{
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int perThread = argc > 2 ? atoi(argv[2]) : 200000;
+
+  mt19937 rng(7);
+  vector<int> keys(n);
+  for (int &key : keys)
+    key = static_cast<int>(rng() % (2 * n));
+
+  // Concurrent inserts: four writers split the key list between them
+  {
+    ConcurrentBST shared;
+    vector<thread> writers;
+    atomic<int> inserted(0);
+    for (int t = 0; t < 4; t++)
+    {
+      writers.emplace_back([&, t]()
+                           {
+        for (int i = t; i < n; i += 4)
+          inserted += shared.insert(keys[i]); });
+    }
+    for (thread &w : writers)
+      w.join();
+    cout << "Distinct keys inserted by 4 writers: " << inserted << endl;
+  }
+
+  // The search benchmark compares trees built from the same keys in the same order, so both have the same shape
+  ConcurrentBST tree;
+  LockedBST locked;
+  int distinct = 0;
+  for (int key : keys)
+  {
+    distinct += tree.insert(key);
+    locked.insert(key);
+  }
+  cout << "Distinct keys inserted by one writer: " << distinct << endl;
+
+  cout << "\n=== Search throughput (M lookups/sec), " << thread::hardware_concurrency() << " hardware threads ===" << endl;
+  cout << "threads  lock-free  global-mutex" << endl;
+  for (int threads = 1; threads <= 64; threads *= 2)
+  {
+    double lockFree = searchThroughput(tree, threads, perThread, 2 * n);
+    double mutexed = searchThroughput(locked, threads, perThread, 2 * n);
+    cout << threads << "\t " << lockFree / 1e6 << "\t    " << mutexed / 1e6 << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,334 @@
+// kary_simd_tree.cpp
+// Implements a k-ary search tree for int keys: a B-tree with 16 key slots per 64-byte-aligned node, searched inside each node with SIMD compares.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KARY_X86 1
+#endif
+using namespace std;
+
+const int SLOTS = 16;           // Key slots per node; unused slots hold INT_MAX
+const int MIN_DEGREE = 8;       // B-tree minimum degree t
+const int MAX_KEYS = 2 * MIN_DEGREE - 1;
+
+struct alignas(64) KNode
+{
+  int keys[SLOTS];
+  KNode *child[SLOTS];
+  int count;
+  bool leaf;
+  explicit KNode(bool isLeaf) : count(0), leaf(isLeaf)
+  {
+    for (int i = 0; i < SLOTS; i++)
+    {
+      keys[i] = INT_MAX;
+      child[i] = nullptr;
+    }
+  }
+};
+
+// Each routine returns how many of the 16 slots hold a key < val (padding never counts), which
+// is the child to descend into. AVX2 needs one compare per 8 keys and SSE2 one per 4.
+static int rankScalar(const int *keys, int val)
+{
+  int r = 0;
+  for (int i = 0; i < SLOTS; i++)
+    r += keys[i] < val;
+  return r;
+}
+
+#ifdef KARY_X86
+static int rankSSE2(const int *keys, int val)
+{
+  __m128i v = _mm_set1_epi32(val);
+  int mask = 0;
+  for (int i = 0; i < SLOTS; i += 4)
+  {
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(keys + i));
+    mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, k))) << i;
+  }
+  return __builtin_popcount(mask);
+}
+
+__attribute__((target("avx2"))) static int rankAVX2(const int *keys, int val)
+{
+  __m256i v = _mm256_set1_epi32(val);
+  __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys));
+  __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys + 8));
+  int maskLo = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, lo)));
+  int maskHi = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, hi)));
+  return __builtin_popcount(maskLo | (maskHi << 8));
+}
+#endif
+
+typedef int (*RankFn)(const int *, int);
+
+class KaryTree
+{
+private:
+  KNode *root;
+  RankFn rank;
+  const char *isa;
+
+  // Splits the full child x->child[i], moving its median key up into x
+  static void splitChild(KNode *x, int i)
+  {
+    KNode *y = x->child[i];
+    KNode *z = new KNode(y->leaf);
+    z->count = MIN_DEGREE - 1;
+    for (int j = 0; j < MIN_DEGREE - 1; j++)
+      z->keys[j] = y->keys[j + MIN_DEGREE];
+    if (!y->leaf)
+    {
+      for (int j = 0; j < MIN_DEGREE; j++)
+      {
+        z->child[j] = y->child[j + MIN_DEGREE];
+        y->child[j + MIN_DEGREE] = nullptr;
+      }
+    }
+    int median = y->keys[MIN_DEGREE - 1];
+    for (int j = MIN_DEGREE - 1; j < SLOTS; j++)
+      y->keys[j] = INT_MAX;
+    y->count = MIN_DEGREE - 1;
+
+    for (int j = x->count; j > i; j--)
+    {
+      x->keys[j] = x->keys[j - 1];
+      x->child[j + 1] = x->child[j];
+    }
+    x->keys[i] = median;
+    x->child[i + 1] = z;
+    x->count++;
+  }
+  static void destroy(KNode *node)
+  {
+    if (!node)
+      return;
+    if (!node->leaf)
+      for (int i = 0; i <= node->count; i++)
+        destroy(node->child[i]);
+    delete node;
+  }
+  static void inorder(const KNode *node)
+  {
+    for (int i = 0; i < node->count; i++)
+    {
+      if (!node->leaf)
+        inorder(node->child[i]);
+      cout << node->keys[i] << " ";
+    }
+    if (!node->leaf)
+      inorder(node->child[node->count]);
+  }
+
+public:
+  // Picks the widest rank routine the CPU supports, falling back to scalar
+  KaryTree() : root(nullptr), rank(rankScalar), isa("scalar")
+  {
+#ifdef KARY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+      rank = rankAVX2;
+      isa = "AVX2";
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+      rank = rankSSE2;
+      isa = "SSE2";
+    }
+#endif
+  }
+  ~KaryTree() { destroy(root); }
+  KaryTree(const KaryTree &) = delete;
+  KaryTree &operator=(const KaryTree &) = delete;
+
+  const char *instructionSet() const { return isa; }
+  void forceScalar()
+  {
+    rank = rankScalar;
+    isa = "scalar";
+  }
+
+  bool search(int val) const
+  {
+    const KNode *node = root;
+    while (node)
+    {
+      int r = rank(node->keys, val); // keys[r] is the first key >= val
+      if (r < node->count && node->keys[r] == val)
+        return true;
+      node = node->leaf ? nullptr : node->child[r];
+    }
+    return false;
+  }
+  // Single-pass B-tree insert: full nodes are split on the way down, so a split never propagates up
+  void insert(int val)
+  {
+    if (search(val))
+      return; // No duplicates
+    if (!root)
+      root = new KNode(true);
+    if (root->count == MAX_KEYS)
+    {
+      KNode *top = new KNode(false);
+      top->child[0] = root;
+      root = top;
+      splitChild(top, 0);
+    }
+    KNode *node = root;
+    while (!node->leaf)
+    {
+      int i = rank(node->keys, val);
+      if (node->child[i]->count == MAX_KEYS)
+      {
+        splitChild(node, i);
+        if (val > node->keys[i])
+          i++;
+      }
+      node = node->child[i];
+    }
+    int i = node->count;
+    while (i > 0 && node->keys[i - 1] > val)
+    {
+      node->keys[i] = node->keys[i - 1];
+      i--;
+    }
+    node->keys[i] = val;
+    node->count++;
+  }
+  int height() const
+  {
+    int h = 0;
+    for (const KNode *node = root; node; node = node->leaf ? nullptr : node->child[0])
+      h++;
+    return h;
+  }
+  void inorder() const
+  {
+    if (root)
+      inorder(root);
+    cout << endl;
+  }
+};
+
+// Binary tree from binary_search_tree.cpp, for comparison
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+
+public:
+  BST() : root(nullptr) {}
+  ~BST()
+  {
+    Node *node = root;
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return;
+    }
+    *link = new Node(val);
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+};
+
+template <typename Tree>
+static double lookupsPerSec(const Tree &tree, const vector<int> &queries, size_t &hits)
+{
+  auto t0 = chrono::steady_clock::now();
+  hits = 0;
+  for (int q : queries)
+    hits += tree.search(q);
+  return queries.size() / chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+// Usage: ./kary_simd_tree [n] [queries]
+int main(int argc, char **argv)
+{
+  KaryTree small;
+  for (int val = 1; val <= 40; val++)
+    small.insert(val);
+  cout << "Inorder traversal: ";
+  small.inorder();
+  cout << "Search 17: " << (small.search(17) ? "Found" : "Not Found") << ", search 41: "
+       << (small.search(41) ? "Found" : "Not Found") << ", height: " << small.height() << endl;
+
+  int n = argc > 1 ? atoi(argv[1]) : 2000000;
+  int q = argc > 2 ? atoi(argv[2]) : 5000000;
+  mt19937 rng(42);
+  vector<int> keys(n), queries(q);
+  KaryTree kary;
+  BST binary;
+  for (int &key : keys)
+  {
+    key = static_cast<int>(rng());
+    kary.insert(key);
+    binary.insert(key);
+  }
+  for (int i = 0; i < q; i++)
+    queries[i] = i % 2 ? keys[rng() % n] : static_cast<int>(rng());
+
+  size_t hitsBinary, hitsSimd, hitsScalar;
+  double binaryRate = lookupsPerSec(binary, queries, hitsBinary);
+  double simdRate = lookupsPerSec(kary, queries, hitsSimd);
+  const char *isa = kary.instructionSet();
+  kary.forceScalar();
+  double scalarRate = lookupsPerSec(kary, queries, hitsScalar);
+
+  cout << "\n=== " << q << " lookups against " << n << " random keys ===" << endl;
+  cout << "binary Node tree:      " << binaryRate / 1e6 << " M lookups/sec" << endl;
+  cout << "16-ary tree (" << isa << "): " << simdRate / 1e6 << " M lookups/sec, height " << kary.height() << endl;
+  cout << "16-ary tree (scalar):  " << scalarRate / 1e6 << " M lookups/sec" << endl;
+  return hitsBinary == hitsSimd && hitsSimd == hitsScalar ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+// learned_index.cpp
+// Freezes a Binary Search Tree into a read-only learned index. Each segment is a linear model that predicts where a key sits in the sorted array, and it is guaranteed to be off by at most epsilon for every key it covers. A lookup binary-searches the small segment array, evaluates one line, and searches a window of about 2 * epsilon slots. On near-uniform keys a handful of segments cover millions of keys. main() benchmarks lookups against the pointer tree and a plain binary search.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <atomic>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class LearnedIndex
+{
+private:
+  struct Segment
+  {
+    int firstKey;
+    double slope;   // Predicted position = start + slope * (key - firstKey)
+    size_t start;   // Position of firstKey
+  };
+  vector<int> keys;
+  vector<Segment> segments;
+  vector<int> segmentKeys; // firstKey of every segment, searched to pick the model
+  size_t epsilon;
+  mutable atomic<size_t> fallbacks; // Lookups whose window did not bracket the key; atomic so readers can share the index
+
+  // Shrinking cone: a segment's feasible slopes are the intersection of [(dy - eps) / dx, (dy + eps) / dx]
+  // over its points. It grows greedily until that interval would become empty.
+  void fit()
+  {
+    size_t begin = 0;
+    while (begin < keys.size())
+    {
+      double lo = 0, hi = INFINITY;
+      size_t end = begin + 1;
+      for (; end < keys.size(); end++)
+      {
+        double dx = double(keys[end]) - keys[begin];
+        double dy = double(end - begin);
+        double newLo = max(lo, (dy - epsilon) / dx), newHi = min(hi, (dy + epsilon) / dx);
+        if (newLo > newHi)
+          break;
+        lo = newLo;
+        hi = newHi;
+      }
+      double slope = end - begin == 1 ? 0 : (lo + hi) / 2;
+      segments.push_back({keys[begin], slope, begin});
+      segmentKeys.push_back(keys[begin]);
+      begin = end;
+    }
+  }
+
+public:
+  // sorted must be strictly increasing (inorder output of a BST)
+  LearnedIndex(vector<int> sorted, size_t eps) : keys(move(sorted)), epsilon(eps), fallbacks(0)
+  {
+    if (eps == 0)
+      throw invalid_argument("epsilon must be at least 1");
+    for (size_t i = 1; i < keys.size(); i++)
+      if (keys[i - 1] >= keys[i])
+        throw invalid_argument("Keys must be strictly increasing");
+    fit();
+  }
+
+  bool search(int val) const
+  {
+    if (keys.empty() || val < keys.front())
+      return false;
+    size_t s = upper_bound(segmentKeys.begin(), segmentKeys.end(), val) - segmentKeys.begin() - 1;
+    const Segment &seg = segments[s];
+    size_t segEnd = s + 1 < segments.size() ? segments[s + 1].start : keys.size();
+
+    // One extra slot on each side absorbs floating-point rounding in the prediction
+    double predicted = seg.start + seg.slope * (double(val) - seg.firstKey);
+    double first = max(double(seg.start), floor(predicted) - double(epsilon) - 1);
+    double last = min(double(segEnd), ceil(predicted) + double(epsilon) + 2);
+    if (first >= last)
+      first = seg.start, last = double(segEnd);
+    const int *lo = keys.data() + size_t(first), *hi = keys.data() + size_t(last);
+    const int *pos = lower_bound(lo, hi, val);
+    if (pos != hi && *pos == val)
+      return true;
+
+    // Fallback: the window should bracket val; if it does not, search the whole segment
+    bool bracketed = (lo == keys.data() + seg.start || lo[-1] < val) && (hi == keys.data() + segEnd || *hi > val);
+    if (bracketed)
+      return false;
+    fallbacks.fetch_add(1, memory_order_relaxed);
+    return binary_search(keys.begin() + seg.start, keys.begin() + segEnd, val);
+  }
+  size_t size() const { return keys.size(); }
+  size_t segmentCount() const { return segments.size(); }
+  size_t modelBytes() const { return segments.size() * (sizeof(Segment) + sizeof(int)); }
+  size_t fallbackCount() const { return fallbacks.load(memory_order_relaxed); }
+};
+
+class BST
+{
+private:
+  Node *root;
+  size_t count;
+
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  BST() : root(nullptr), count(0) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+    count++;
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  vector<int> sortedKeys() const
+  {
+    vector<int> sorted;
+    sorted.reserve(count);
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      sorted.push_back(curr->data);
+      curr = curr->right;
+    }
+    return sorted;
+  }
+  // Snapshot of the current keys as a read-only learned index with the given error bound
+  LearnedIndex freeze(size_t epsilon) const { return LearnedIndex(sortedKeys(), epsilon); }
+};
+
+// Sorted array searched with std::binary_search, as a baseline
+class SortedArray
+{
+private:
+  vector<int> keys;
+
+public:
+  explicit SortedArray(vector<int> sorted) : keys(move(sorted)) {}
+  bool search(int val) const { return binary_search(keys.begin(), keys.end(), val); }
+};
+
+template <typename Index>
+static double lookupsPerSec(const Index &index, const vector<int> &queries, size_t &found)
+{
+  auto t0 = chrono::steady_clock::now();
+  found = 0;
+  for (int q : queries)
+    found += index.search(q);
+  auto t1 = chrono::steady_clock::now();
+  return queries.size() / chrono::duration<double>(t1 - t0).count();
+}
+
+// Usage: ./learned_index [n] [queries] [epsilon]
+int main(int argc, char **argv)
+{
+  BST tree;
+  for (int val : {50, 30, 70, 20, 40, 60, 80, 1000})
+    tree.insert(val);
+  LearnedIndex index = tree.freeze(1);
+  cout << "Segments for 8 keys (epsilon 1): " << index.segmentCount() << endl;
+  for (int key : {20, 45, 80, 1000, 1001})
+    cout << "Search " << key << ": " << (index.search(key) ? "Found" : "Not Found") << endl;
+
+  size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+  size_t q = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000000;
+  size_t epsilon = argc > 3 ? strtoull(argv[3], nullptr, 10) : 32;
+  mt19937 rng(42);
+  vector<int> keys(n);
+  BST big;
+  for (int &key : keys)
+  {
+    key = static_cast<int>(rng() >> 1); // Near-uniform over [0, 2^31)
+    big.insert(key);
+  }
+  LearnedIndex learned = big.freeze(epsilon);
+  SortedArray array(big.sortedKeys());
+
+  // Half the queries hit, half are random (almost always misses)
+  vector<int> queries(q);
+  for (size_t i = 0; i < q; i++)
+    queries[i] = i % 2 ? keys[rng() % n] : static_cast<int>(rng() >> 1);
+
+  size_t foundTree, foundArray, foundLearned;
+  double treeRate = lookupsPerSec(big, queries, foundTree);
+  double arrayRate = lookupsPerSec(array, queries, foundArray);
+  double learnedRate = lookupsPerSec(learned, queries, foundLearned);
+  cout << "\n=== Search benchmark: " << learned.size() << " keys, " << q << " queries, epsilon " << epsilon << " ===" << endl;
+  cout << "learned index: " << learned.segmentCount() << " segments, " << learned.modelBytes() << " bytes of model, "
+       << learned.fallbackCount() << " fallback searches" << endl;
+  cout << "pointer tree:  " << treeRate / 1e6 << " M lookups/sec (" << foundTree << " hits)" << endl;
+  cout << "binary search: " << arrayRate / 1e6 << " M lookups/sec (" << foundArray << " hits)" << endl;
+  cout << "learned index: " << learnedRate / 1e6 << " M lookups/sec (" << foundLearned << " hits)" << endl;
+  return foundTree == foundLearned && foundArray == foundLearned ? 0 : 1;
+}
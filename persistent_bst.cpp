@@ -0,0 +1,182 @@
+// persistent_bst.cpp
+// Implements a persistent (copy-on-write) Binary Search Tree. Nodes are immutable and shared between versions; insert copies only the root-to-leaf path (AVL-balanced, so O(log n) new nodes), snapshot() is O(1) and hands out a consistent read-only version, and reference counting frees old nodes once the last snapshot using them is dropped.
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+class Node;
+using NodePtr = shared_ptr<const Node>;
+
+class Node
+{
+public:
+  static atomic<long> live;    // Nodes currently allocated, across all versions
+  static atomic<long> created; // Nodes ever allocated
+
+  const int data;
+  const int height;
+  const int size; // Number of keys in this subtree
+  const NodePtr left;
+  const NodePtr right;
+  Node(int val, NodePtr l, NodePtr r)
+      : data(val), height(1 + max(l ? l->height : 0, r ? r->height : 0)),
+        size(1 + (l ? l->size : 0) + (r ? r->size : 0)), left(move(l)), right(move(r))
+  {
+    live++;
+    created++;
+  }
+  ~Node() { live--; }
+};
+atomic<long> Node::live(0);
+atomic<long> Node::created(0);
+
+// Read-only view of one version of the tree; safe to use from any thread
+class Snapshot
+{
+private:
+  NodePtr root;
+
+public:
+  explicit Snapshot(NodePtr r) : root(move(r)) {}
+  bool search(int val) const
+  {
+    const Node *curr = root.get();
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = (val < curr->data ? curr->left : curr->right).get();
+    }
+    return false;
+  }
+  int size() const { return root ? root->size : 0; }
+  void inorder() const
+  {
+    vector<const Node *> stack;
+    const Node *curr = root.get();
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left.get();
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << " ";
+      curr = curr->right.get();
+    }
+    cout << endl;
+  }
+};
+
+class PersistentBST
+{
+private:
+  NodePtr root; // Only read and replaced through atomic_load/atomic_store
+  mutex writer; // Serializes writers; readers never take it
+
+  static int height(const NodePtr &node) { return node ? node->height : 0; }
+  static NodePtr make(int val, NodePtr l, NodePtr r) { return make_shared<const Node>(val, move(l), move(r)); }
+
+  // Builds a node from (l, val, r), rotating with fresh copies if the AVL invariant is broken
+  static NodePtr balance(int val, const NodePtr &l, const NodePtr &r)
+  {
+    if (height(l) > height(r) + 1)
+    {
+      if (height(l->left) >= height(l->right))
+        return make(l->data, l->left, make(val, l->right, r));
+      const NodePtr &lr = l->right;
+      return make(lr->data, make(l->data, l->left, lr->left), make(val, lr->right, r));
+    }
+    if (height(r) > height(l) + 1)
+    {
+      if (height(r->right) >= height(r->left))
+        return make(r->data, make(val, l, r->left), r->right);
+      const NodePtr &rl = r->left;
+      return make(rl->data, make(val, l, rl->left), make(r->data, rl->right, r->right));
+    }
+    return make(val, l, r);
+  }
+  // Returns the new subtree root, or node itself when val is already present (nothing is copied)
+  static NodePtr insert(const NodePtr &node, int val)
+  {
+    if (!node)
+      return make(val, nullptr, nullptr);
+    if (val < node->data)
+    {
+      NodePtr l = insert(node->left, val);
+      return l == node->left ? node : balance(node->data, l, node->right);
+    }
+    if (val > node->data)
+    {
+      NodePtr r = insert(node->right, val);
+      return r == node->right ? node : balance(node->data, node->left, r);
+    }
+    return node;
+  }
+
+public:
+  // The path copy runs outside any lock readers take; only the finished root is published
+  void insert(int val)
+  {
+    lock_guard<mutex> guard(writer);
+    NodePtr current = atomic_load(&root);
+    NodePtr next = insert(current, val);
+    if (next != current)
+      atomic_store(&root, move(next));
+  }
+  // O(1): the snapshot just shares the current root, and never waits for an insert in progress
+  Snapshot snapshot() const { return Snapshot(atomic_load(&root)); }
+  bool search(int val) const { return snapshot().search(val); }
+};
+
+int main()
+{
+  {
+    PersistentBST tree;
+    for (int val : {5, 3, 7, 2, 4, 6, 8})
+      tree.insert(val);
+    Snapshot before = tree.snapshot();
+    tree.insert(1);
+    tree.insert(9);
+    cout << "Snapshot: ";
+    before.inorder();
+    cout << "Current:  ";
+    tree.snapshot().inorder();
+  }
+
+  // A reporting thread reads a fixed version while ingest keeps inserting
+  const int n = 1000000;
+  PersistentBST big;
+  for (int i = 0; i < n / 2; i++)
+    big.insert(i);
+  Snapshot report = big.snapshot();
+  long liveBefore = Node::live, createdBefore = Node::created;
+  auto t0 = chrono::steady_clock::now();
+  thread reader([&report]()
+                {
+    long found = 0;
+    for (int i = 0; i < n; i++)
+      found += report.search(i);
+    cout << "Reader saw " << found << " keys (snapshot size " << report.size() << ")" << endl; });
+  for (int i = n / 2; i < n; i++)
+    big.insert(i);
+  reader.join();
+  auto t1 = chrono::steady_clock::now();
+  long pinned = Node::live - liveBefore - n / 2;
+
+  cout << "Inserted " << n / 2 << " keys in " << chrono::duration<double, milli>(t1 - t0).count()
+       << " ms, " << double(Node::created - createdBefore) / (n / 2) << " nodes allocated per insert, "
+       << pinned << " old nodes kept alive by the snapshot" << endl;
+  report = Snapshot(nullptr);
+  cout << "After dropping the snapshot: " << Node::live << " live nodes for "
+       << big.snapshot().size() << " keys" << endl;
+  return 0;
+}
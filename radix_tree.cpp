@@ -0,0 +1,542 @@
+// radix_tree.cpp
+// Implements an adaptive radix tree (ART) for int keys, with the same insert/search/findMin/findMax/inorder API as the BST.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+static_assert(sizeof(uintptr_t) >= 8, "Leaves are packed into pointers, which needs 64-bit pointers");
+
+// Each inner node branches on one byte of the key and grows from 4 to 16 to 48 to 256 child slots
+// as it fills. Path compression keeps a lookup to at most four nodes whatever the key set.
+enum NodeType : uint8_t
+{
+  NODE4,
+  NODE16,
+  NODE48,
+  NODE256
+};
+
+// Header shared by all inner node sizes. prefix holds the bytes every key below this node shares
+// after the parent's branch byte; at most 3, since a node must still branch on one of the 4 bytes.
+struct Inner
+{
+  NodeType type;
+  uint8_t prefixLen;
+  uint16_t count; // Children in use
+  uint8_t prefix[3];
+  explicit Inner(NodeType t) : type(t), prefixLen(0), count(0), prefix{} {}
+};
+
+struct Inner4 : Inner
+{
+  uint8_t keys[4]; // Sorted branch bytes
+  Inner *child[4];
+  Inner4() : Inner(NODE4), keys{}, child{} {}
+};
+
+struct Inner16 : Inner
+{
+  uint8_t keys[16]; // Sorted branch bytes
+  Inner *child[16];
+  Inner16() : Inner(NODE16), keys{}, child{} {}
+};
+
+struct Inner48 : Inner
+{
+  uint8_t index[256]; // Branch byte -> slot in child, plus one (0 = no child)
+  Inner *child[48];
+  Inner48() : Inner(NODE48), index{}, child{} {}
+};
+
+struct Inner256 : Inner
+{
+  Inner *child[256];
+  Inner256() : Inner(NODE256), child{} {}
+};
+
+class RadixTree
+{
+private:
+  Inner *root;
+  size_t keyCount;
+  size_t nodeBytes; // Memory held by inner nodes
+
+  // Keys are read most significant byte first; flipping the sign bit makes byte order match int order
+  static uint32_t toKey(int val) { return uint32_t(val) ^ 0x80000000u; }
+  static int fromKey(uint32_t key) { return int(key ^ 0x80000000u); }
+  static uint8_t byteAt(uint32_t key, int depth) { return uint8_t(key >> (24 - 8 * depth)); }
+
+  // Leaves are not allocated: the key is stored in the child pointer itself, tagged by its low bit
+  static bool isLeaf(const Inner *node) { return reinterpret_cast<uintptr_t>(node) & 1; }
+  static Inner *makeLeaf(uint32_t key) { return reinterpret_cast<Inner *>((uintptr_t(key) << 1) | 1); }
+  static uint32_t leafKey(const Inner *node) { return uint32_t(reinterpret_cast<uintptr_t>(node) >> 1); }
+
+  // Slot holding the child for branch byte b, or nullptr
+  static Inner **findChild(Inner *node, uint8_t b)
+  {
+    switch (node->type)
+    {
+    case NODE4:
+    {
+      Inner4 *n = static_cast<Inner4 *>(node);
+      for (int i = 0; i < n->count; i++)
+        if (n->keys[i] == b)
+          return &n->child[i];
+      return nullptr;
+    }
+    case NODE16:
+    {
+      Inner16 *n = static_cast<Inner16 *>(node);
+#ifdef __SSE2__
+      __m128i eq = _mm_cmpeq_epi8(_mm_set1_epi8(char(b)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys)));
+      int mask = _mm_movemask_epi8(eq) & ((1 << n->count) - 1);
+      return mask ? &n->child[__builtin_ctz(mask)] : nullptr;
+#else
+      for (int i = 0; i < n->count; i++)
+        if (n->keys[i] == b)
+          return &n->child[i];
+      return nullptr;
+#endif
+    }
+    case NODE48:
+    {
+      Inner48 *n = static_cast<Inner48 *>(node);
+      return n->index[b] ? &n->child[n->index[b] - 1] : nullptr;
+    }
+    default:
+    {
+      Inner256 *n = static_cast<Inner256 *>(node);
+      return n->child[b] ? &n->child[b] : nullptr;
+    }
+    }
+  }
+
+  template <typename T>
+  T *allocate()
+  {
+    nodeBytes += sizeof(T);
+    return new T();
+  }
+  template <typename T>
+  void release(T *node)
+  {
+    nodeBytes -= sizeof(T);
+    delete node;
+  }
+  static void copyHeader(Inner *to, const Inner *from)
+  {
+    to->prefixLen = from->prefixLen;
+    to->count = from->count;
+    copy(from->prefix, from->prefix + 3, to->prefix);
+  }
+
+  // Inserts into sorted keys/child arrays of a Node4 or Node16 that has room
+  template <typename T>
+  static void insertSorted(T *n, uint8_t b, Inner *child)
+  {
+    int i = n->count;
+    while (i > 0 && n->keys[i - 1] > b)
+    {
+      n->keys[i] = n->keys[i - 1];
+      n->child[i] = n->child[i - 1];
+      i--;
+    }
+    n->keys[i] = b;
+    n->child[i] = child;
+    n->count++;
+  }
+  // Adds child under branch byte b, replacing *ref with a larger node when this one is full
+  void addChild(Inner **ref, uint8_t b, Inner *child)
+  {
+    Inner *node = *ref;
+    switch (node->type)
+    {
+    case NODE4:
+    {
+      Inner4 *n = static_cast<Inner4 *>(node);
+      if (n->count < 4)
+        return insertSorted(n, b, child);
+      Inner16 *grown = allocate<Inner16>();
+      copyHeader(grown, n);
+      copy(n->keys, n->keys + 4, grown->keys);
+      copy(n->child, n->child + 4, grown->child);
+      release(n);
+      *ref = grown;
+      return insertSorted(grown, b, child);
+    }
+    case NODE16:
+    {
+      Inner16 *n = static_cast<Inner16 *>(node);
+      if (n->count < 16)
+        return insertSorted(n, b, child);
+      Inner48 *grown = allocate<Inner48>();
+      copyHeader(grown, n);
+      for (int i = 0; i < 16; i++)
+      {
+        grown->child[i] = n->child[i];
+        grown->index[n->keys[i]] = uint8_t(i + 1);
+      }
+      release(n);
+      *ref = node = grown;
+    }
+      [[fallthrough]];
+    case NODE48:
+    {
+      Inner48 *n = static_cast<Inner48 *>(node);
+      if (n->count < 48)
+      {
+        // Keys are never removed, so slots fill in order
+        n->child[n->count] = child;
+        n->index[b] = uint8_t(++n->count);
+        return;
+      }
+      Inner256 *grown = allocate<Inner256>();
+      copyHeader(grown, n);
+      for (int b2 = 0; b2 < 256; b2++)
+        if (n->index[b2])
+          grown->child[b2] = n->child[n->index[b2] - 1];
+      release(n);
+      *ref = node = grown;
+    }
+      [[fallthrough]];
+    default:
+    {
+      Inner256 *n = static_cast<Inner256 *>(node);
+      n->child[b] = child;
+      n->count++;
+    }
+    }
+  }
+
+  // Returns false if the key was already present
+  bool insert(Inner **ref, uint32_t key, int depth)
+  {
+    while (true)
+    {
+      Inner *node = *ref;
+      if (!node)
+      {
+        *ref = makeLeaf(key);
+        return true;
+      }
+      if (isLeaf(node))
+      {
+        uint32_t other = leafKey(node);
+        if (other == key)
+          return false;
+        // Split the leaf: a Node4 holding the bytes both keys share, branching where they differ
+        Inner4 *split = allocate<Inner4>();
+        int p = 0;
+        while (byteAt(key, depth + p) == byteAt(other, depth + p))
+          split->prefix[p] = byteAt(key, depth + p), p++;
+        split->prefixLen = uint8_t(p);
+        insertSorted(split, byteAt(other, depth + p), node);
+        insertSorted(split, byteAt(key, depth + p), makeLeaf(key));
+        *ref = split;
+        return true;
+      }
+      int p = 0;
+      while (p < node->prefixLen && node->prefix[p] == byteAt(key, depth + p))
+        p++;
+      if (p < node->prefixLen)
+      {
+        // The key leaves the compressed path at byte p: put a Node4 above node at that point
+        Inner4 *split = allocate<Inner4>();
+        split->prefixLen = uint8_t(p);
+        copy(node->prefix, node->prefix + p, split->prefix);
+        uint8_t branch = node->prefix[p];
+        node->prefixLen = uint8_t(node->prefixLen - p - 1);
+        copy(node->prefix + p + 1, node->prefix + p + 1 + node->prefixLen, node->prefix);
+        insertSorted(split, branch, node);
+        insertSorted(split, byteAt(key, depth + p), makeLeaf(key));
+        *ref = split;
+        return true;
+      }
+      depth += node->prefixLen;
+      Inner **next = findChild(node, byteAt(key, depth));
+      if (!next)
+      {
+        addChild(ref, byteAt(key, depth), makeLeaf(key));
+        return true;
+      }
+      ref = next;
+      depth++;
+    }
+  }
+
+  void destroy(Inner *node)
+  {
+    if (!node || isLeaf(node))
+      return;
+    switch (node->type)
+    {
+    case NODE4:
+    {
+      Inner4 *n = static_cast<Inner4 *>(node);
+      for (int i = 0; i < n->count; i++)
+        destroy(n->child[i]);
+      return release(n);
+    }
+    case NODE16:
+    {
+      Inner16 *n = static_cast<Inner16 *>(node);
+      for (int i = 0; i < n->count; i++)
+        destroy(n->child[i]);
+      return release(n);
+    }
+    case NODE48:
+    {
+      Inner48 *n = static_cast<Inner48 *>(node);
+      for (int i = 0; i < n->count; i++)
+        destroy(n->child[i]);
+      return release(n);
+    }
+    default:
+    {
+      Inner256 *n = static_cast<Inner256 *>(node);
+      for (Inner *child : n->child)
+        destroy(child);
+      return release(n);
+    }
+    }
+  }
+  // Children of node in increasing branch-byte order
+  static vector<Inner *> children(Inner *node)
+  {
+    vector<Inner *> out;
+    switch (node->type)
+    {
+    case NODE4:
+    {
+      Inner4 *n = static_cast<Inner4 *>(node);
+      out.assign(n->child, n->child + n->count);
+      break;
+    }
+    case NODE16:
+    {
+      Inner16 *n = static_cast<Inner16 *>(node);
+      out.assign(n->child, n->child + n->count);
+      break;
+    }
+    case NODE48:
+    {
+      Inner48 *n = static_cast<Inner48 *>(node);
+      for (int b = 0; b < 256; b++)
+        if (n->index[b])
+          out.push_back(n->child[n->index[b] - 1]);
+      break;
+    }
+    default:
+    {
+      Inner256 *n = static_cast<Inner256 *>(node);
+      for (Inner *child : n->child)
+        if (child)
+          out.push_back(child);
+    }
+    }
+    return out;
+  }
+  static void inorder(Inner *node)
+  {
+    if (isLeaf(node))
+    {
+      cout << fromKey(leafKey(node)) << " ";
+      return;
+    }
+    for (Inner *child : children(node))
+      inorder(child);
+  }
+
+public:
+  RadixTree() : root(nullptr), keyCount(0), nodeBytes(0) {}
+  ~RadixTree() { destroy(root); }
+  RadixTree(const RadixTree &) = delete;
+  RadixTree &operator=(const RadixTree &) = delete;
+
+  void insert(int val)
+  {
+    if (insert(&root, toKey(val), 0))
+      keyCount++;
+  }
+  bool search(int val) const
+  {
+    uint32_t key = toKey(val);
+    Inner *node = root;
+    int depth = 0;
+    while (node && !isLeaf(node))
+    {
+      for (int i = 0; i < node->prefixLen; i++)
+        if (node->prefix[i] != byteAt(key, depth + i))
+          return false;
+      depth += node->prefixLen;
+      Inner **slot = findChild(node, byteAt(key, depth));
+      node = slot ? *slot : nullptr;
+      depth++;
+    }
+    return node && leafKey(node) == key;
+  }
+  int findMin() const
+  {
+    if (!root)
+      throw runtime_error("Tree is empty");
+    Inner *node = root;
+    while (!isLeaf(node))
+      node = children(node).front();
+    return fromKey(leafKey(node));
+  }
+  int findMax() const
+  {
+    if (!root)
+      throw runtime_error("Tree is empty");
+    Inner *node = root;
+    while (!isLeaf(node))
+      node = children(node).back();
+    return fromKey(leafKey(node));
+  }
+  void inorder() const
+  {
+    if (root)
+      inorder(root);
+    cout << endl;
+  }
+  size_t size() const { return keyCount; }
+  size_t memoryBytes() const { return nodeBytes; }
+};
+
+// Pointer BST from binary_search_tree.cpp, for comparison
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), left(nullptr), right(nullptr) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+  size_t count;
+
+public:
+  BST() : root(nullptr), count(0) {}
+  ~BST()
+  {
+    Node *node = root;
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+  void insert(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return;
+    }
+    *link = new Node(val);
+    count++;
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  size_t memoryBytes() const { return count * sizeof(Node); }
+};
+
+template <typename Tree>
+static double lookupsPerSec(const Tree &tree, const vector<int> &queries, size_t &hits)
+{
+  auto t0 = chrono::steady_clock::now();
+  hits = 0;
+  for (int q : queries)
+    hits += tree.search(q);
+  return queries.size() / chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+static bool compare(const char *label, const vector<int> &keys, const vector<int> &queries)
+{
+  RadixTree radix;
+  BST bst;
+  for (int key : keys)
+  {
+    radix.insert(key);
+    bst.insert(key);
+  }
+  size_t hitsRadix, hitsBst;
+  double radixRate = lookupsPerSec(radix, queries, hitsRadix);
+  double bstRate = lookupsPerSec(bst, queries, hitsBst);
+  cout << label << " (" << radix.size() << " keys):" << endl;
+  cout << "  radix tree: " << radixRate / 1e6 << " M lookups/sec, " << radix.memoryBytes() / radix.size() << " bytes/key" << endl;
+  cout << "  BST:        " << bstRate / 1e6 << " M lookups/sec, " << bst.memoryBytes() / radix.size() << " bytes/key (before malloc overhead)" << endl;
+  return hitsRadix == hitsBst;
+}
+
+// Usage: ./radix_tree [n] [queries]
+int main(int argc, char **argv)
+{
+  RadixTree tree;
+  for (int val : {50, -3, 70, 260, 20, 65536, 40, 60, 80})
+    tree.insert(val);
+  cout << "Inorder traversal: ";
+  tree.inorder();
+  cout << "Min: " << tree.findMin() << ", max: " << tree.findMax() << ", search 260: "
+       << (tree.search(260) ? "Found" : "Not Found") << ", search 261: " << (tree.search(261) ? "Found" : "Not Found") << endl;
+
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int q = argc > 2 ? atoi(argv[2]) : 5000000;
+  mt19937 rng(42);
+  vector<int> sparse(n), dense(n), queries(q);
+  for (int i = 0; i < n; i++)
+  {
+    sparse[i] = static_cast<int>(rng());
+    dense[i] = i; // Consecutive IDs, inserted in random order
+  }
+  shuffle(dense.begin(), dense.end(), rng);
+
+  cout << "\n=== " << q << " lookups, half hits ===" << endl;
+  for (int i = 0; i < q; i++)
+    queries[i] = i % 2 ? sparse[rng() % n] : static_cast<int>(rng());
+  bool same = compare("sparse random keys", sparse, queries);
+  for (int i = 0; i < q; i++)
+    queries[i] = static_cast<int>(rng() % (2 * n));
+  same &= compare("dense keys 0..n-1", dense, queries);
+  return same ? 0 : 1;
+}
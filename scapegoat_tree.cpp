@@ -0,0 +1,265 @@
+// scapegoat_tree.cpp
+// Implements a scapegoat Binary Search Tree with erase. erase only marks a node as a tombstone; once tombstones make up half of some subtree on the erased key's path, that subtree is rebuilt without them. insert rebuilds the lowest too-unbalanced ancestor (the scapegoat) whenever a new leaf lands deeper than log base 1/alpha of the tree size. Both operations are amortized O(log n), and the tree never needs a periodic global rebuild.
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+
+class Node
+{
+public:
+  int data;
+  bool deleted; // Tombstone: erased but still linked into the tree
+  int size;     // Nodes in this subtree, tombstones included
+  int dead;     // Tombstones in this subtree
+  Node *left;
+  Node *right;
+  Node(int val) : data(val), deleted(false), size(1), dead(0), left(nullptr), right(nullptr) {}
+};
+
+class ScapegoatTree
+{
+private:
+  static constexpr double ALPHA = 0.7; // A child may hold at most this fraction of its parent's subtree
+  Node *root;
+  int live;          // Keys currently in the tree
+  long rebuiltNodes; // Nodes touched by partial rebuilds (for reporting)
+
+  static int size(Node *node) { return node ? node->size : 0; }
+
+  // Builds a perfectly balanced subtree from nodes[lo, hi)
+  static Node *build(const vector<Node *> &nodes, size_t lo, size_t hi)
+  {
+    if (lo == hi)
+      return nullptr;
+    size_t mid = lo + (hi - lo) / 2;
+    Node *node = nodes[mid];
+    node->left = build(nodes, lo, mid);
+    node->right = build(nodes, mid + 1, hi);
+    node->size = static_cast<int>(hi - lo);
+    node->dead = 0;
+    return node;
+  }
+  // Rebuilds the subtree at *link, freeing its tombstones
+  void rebuild(Node **link)
+  {
+    vector<Node *> nodes, stack;
+    Node *curr = *link;
+    rebuiltNodes += size(curr);
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      Node *next = curr->right;
+      if (curr->deleted)
+        delete curr;
+      else
+        nodes.push_back(curr);
+      curr = next;
+    }
+    *link = build(nodes, 0, nodes.size());
+  }
+  // Rebuilds the subtree at path[i]; its ancestors (path[0..i)) lose the tombstones it drops
+  void rebuildAt(const vector<Node **> &path, size_t i)
+  {
+    int removed = (*path[i])->dead;
+    rebuild(path[i]);
+    for (size_t j = 0; j < i; j++)
+    {
+      (*path[j])->size -= removed;
+      (*path[j])->dead -= removed;
+    }
+  }
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  ScapegoatTree() : root(nullptr), live(0), rebuiltNodes(0) {}
+  ~ScapegoatTree() { destroy(root); }
+  ScapegoatTree(const ScapegoatTree &) = delete;
+  ScapegoatTree &operator=(const ScapegoatTree &) = delete;
+
+  void insert(int val)
+  {
+    vector<Node **> path; // Links from the root down to the inserted node
+    Node **link = &root;
+    while (*link)
+    {
+      path.push_back(link);
+      Node *node = *link;
+      if (val == node->data)
+      {
+        if (node->deleted)
+        {
+          // Revive the tombstone instead of adding a node
+          node->deleted = false;
+          for (Node **p : path)
+            (*p)->dead--;
+          live++;
+        }
+        return;
+      }
+      link = val < node->data ? &node->left : &node->right;
+    }
+    *link = new Node(val);
+    for (Node **p : path)
+      (*p)->size++;
+    live++;
+
+    // Depth of the new node exceeds log_{1/alpha}(n): some ancestor is alpha-unbalanced
+    size_t depth = path.size();
+    if (depth > log(double(size(root))) / log(1.0 / ALPHA))
+    {
+      for (size_t i = path.size(); i-- > 0;)
+      {
+        Node *ancestor = *path[i];
+        if (max(size(ancestor->left), size(ancestor->right)) > ALPHA * ancestor->size)
+        {
+          rebuildAt(path, i);
+          break;
+        }
+      }
+    }
+  }
+  // Marks val as erased; returns false if it is not present
+  bool erase(int val)
+  {
+    vector<Node **> path;
+    Node **link = &root;
+    while (*link && (*link)->data != val)
+    {
+      path.push_back(link);
+      link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    if (!*link || (*link)->deleted)
+      return false;
+    path.push_back(link);
+    (*link)->deleted = true;
+    for (Node **p : path)
+      (*p)->dead++;
+    live--;
+
+    // Rebuild the highest subtree on the path that is at least half tombstones
+    for (size_t i = 0; i < path.size(); i++)
+    {
+      Node *node = *path[i];
+      if (2 * node->dead >= node->size)
+      {
+        rebuildAt(path, i);
+        break;
+      }
+    }
+    return true;
+  }
+  bool search(int val) const
+  {
+    Node *curr = root;
+    while (curr)
+    {
+      if (curr->data == val)
+        return !curr->deleted;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  int count() const { return live; }
+  int tombstones() const { return root ? root->dead : 0; }
+  long rebuildWork() const { return rebuiltNodes; }
+  int height() const
+  {
+    int levels = 0;
+    vector<Node *> level;
+    if (root)
+      level.push_back(root);
+    while (!level.empty())
+    {
+      vector<Node *> next;
+      for (Node *node : level)
+      {
+        if (node->left)
+          next.push_back(node->left);
+        if (node->right)
+          next.push_back(node->right);
+      }
+      level.swap(next);
+      levels++;
+    }
+    return levels;
+  }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      if (!curr->deleted)
+        cout << curr->data << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+};
+
+// Usage: ./scapegoat_tree [n]
+int main(int argc, char **argv)
+{
+  ScapegoatTree tree;
+  for (int val = 1; val <= 10; val++)
+    tree.insert(val); // Sorted input: scapegoat rebuilds keep the height logarithmic
+  tree.erase(3);
+  tree.erase(7);
+  cout << "Inorder traversal: ";
+  tree.inorder();
+  cout << "Search 3: " << (tree.search(3) ? "Found" : "Not Found") << ", height: " << tree.height()
+       << ", tombstones: " << tree.tombstones() << endl;
+
+  // Sliding window: insert increasing IDs and expire the oldest ones, as a nightly purge would
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int window = n / 4;
+  auto t0 = chrono::steady_clock::now();
+  ScapegoatTree ids;
+  for (int i = 0; i < n; i++)
+  {
+    ids.insert(i);
+    if (i >= window)
+      ids.erase(i - window);
+  }
+  auto t1 = chrono::steady_clock::now();
+  double ms = chrono::duration<double, milli>(t1 - t0).count();
+  cout << "\n" << n << " inserts + " << n - window << " erases: " << ms << " ms, "
+       << ids.count() << " live keys, height " << ids.height() << ", " << ids.tombstones()
+       << " tombstones, rebuild work " << double(ids.rebuildWork()) / (2 * n - window) << " nodes/op" << endl;
+  return 0;
+}
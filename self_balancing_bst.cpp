@@ -0,0 +1,428 @@
+// self_balancing_bst.cpp
+// Implements a Binary Search Tree with a selectable balancing policy: NONE (plain BST), AVL (height-balanced rotations), RED_BLACK (left-leaning red-black tree) or SPLAY (top-down splay tree). Balanced modes keep the height O(log n) even for sorted insert orders; SPLAY moves every accessed key to the root, so hot keys stay near the top under skewed workloads (amortized O(log n) per operation). main() benchmarks search latency on sorted inserts and on a Zipf(1.1) access trace for each policy.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+
+enum class Balance
+{
+  NONE,
+  AVL,
+  RED_BLACK,
+  SPLAY
+};
+
+class Node
+{
+public:
+  int data;
+  Node *left;
+  Node *right;
+  int height; // Used by AVL
+  bool red;   // Used by RED_BLACK (new links are red)
+  Node(int val) : data(val), left(nullptr), right(nullptr), height(1), red(true) {}
+};
+
+class BST
+{
+private:
+  Node *root;
+  Balance policy;
+
+  static int height(Node *node) { return node ? node->height : 0; }
+  static bool isRed(Node *node) { return node && node->red; }
+  static void update(Node *node) { node->height = 1 + max(height(node->left), height(node->right)); }
+
+  static Node *rotateLeft(Node *node)
+  {
+    Node *x = node->right;
+    node->right = x->left;
+    x->left = node;
+    update(node);
+    update(x);
+    return x;
+  }
+  static Node *rotateRight(Node *node)
+  {
+    Node *x = node->left;
+    node->left = x->right;
+    x->right = node;
+    update(node);
+    update(x);
+    return x;
+  }
+
+  // Plain BST insert, written as a loop so sorted input cannot overflow the stack
+  void insertPlain(int val)
+  {
+    Node **link = &root;
+    while (*link)
+    {
+      if (val < (*link)->data)
+        link = &(*link)->left;
+      else if (val > (*link)->data)
+        link = &(*link)->right;
+      else
+        return; // No duplicates
+    }
+    *link = new Node(val);
+  }
+
+  Node *balanceAVL(Node *node)
+  {
+    update(node);
+    int factor = height(node->left) - height(node->right);
+    if (factor > 1)
+    {
+      if (height(node->left->left) < height(node->left->right))
+        node->left = rotateLeft(node->left); // Left-right case
+      return rotateRight(node);
+    }
+    if (factor < -1)
+    {
+      if (height(node->right->right) < height(node->right->left))
+        node->right = rotateRight(node->right); // Right-left case
+      return rotateLeft(node);
+    }
+    return node;
+  }
+  Node *insertAVL(Node *node, int val)
+  {
+    if (!node)
+      return new Node(val);
+    if (val < node->data)
+      node->left = insertAVL(node->left, val);
+    else if (val > node->data)
+      node->right = insertAVL(node->right, val);
+    else
+      return node;
+    return balanceAVL(node);
+  }
+
+  // Left-leaning red-black insert (Sedgewick): red links lean left, no node has two red links
+  Node *insertRB(Node *node, int val)
+  {
+    if (!node)
+      return new Node(val);
+    if (val < node->data)
+      node->left = insertRB(node->left, val);
+    else if (val > node->data)
+      node->right = insertRB(node->right, val);
+    else
+      return node;
+
+    if (isRed(node->right) && !isRed(node->left))
+    {
+      bool color = node->red;
+      node = rotateLeft(node);
+      node->red = color;
+      node->left->red = true;
+    }
+    if (isRed(node->left) && isRed(node->left->left))
+    {
+      bool color = node->red;
+      node = rotateRight(node);
+      node->red = color;
+      node->right->red = true;
+    }
+    if (isRed(node->left) && isRed(node->right))
+    {
+      node->red = true;
+      node->left->red = false;
+      node->right->red = false;
+    }
+    return node;
+  }
+
+  // Top-down splay (Sleator-Tarjan): brings val, or the last node on its search path, to the root.
+  // Nodes left of the path are collected in a "left tree", nodes right of it in a "right tree".
+  static Node *splay(Node *node, int val)
+  {
+    if (!node)
+      return nullptr;
+    Node header(0);
+    Node *leftMax = &header, *rightMin = &header;
+    while (true)
+    {
+      if (val < node->data)
+      {
+        if (!node->left)
+          break;
+        if (val < node->left->data)
+        {
+          Node *l = node->left; // Zig-zig: rotate right first
+          node->left = l->right;
+          l->right = node;
+          node = l;
+          if (!node->left)
+            break;
+        }
+        rightMin->left = node; // Link node into the right tree
+        rightMin = node;
+        node = node->left;
+      }
+      else if (val > node->data)
+      {
+        if (!node->right)
+          break;
+        if (val > node->right->data)
+        {
+          Node *r = node->right; // Zag-zag: rotate left first
+          node->right = r->left;
+          r->left = node;
+          node = r;
+          if (!node->right)
+            break;
+        }
+        leftMax->right = node; // Link node into the left tree
+        leftMax = node;
+        node = node->right;
+      }
+      else
+        break;
+    }
+    // Reassemble: the left and right trees become the new root's subtrees
+    leftMax->right = node->left;
+    rightMin->left = node->right;
+    node->left = header.right;
+    node->right = header.left;
+    return node;
+  }
+  void insertSplay(int val)
+  {
+    root = splay(root, val);
+    if (root && root->data == val)
+      return; // No duplicates
+    Node *node = new Node(val);
+    if (root && val < root->data)
+    {
+      node->left = root->left;
+      node->right = root;
+      root->left = nullptr;
+    }
+    else if (root)
+    {
+      node->right = root->right;
+      node->left = root;
+      root->right = nullptr;
+    }
+    root = node;
+  }
+
+  // Tears the tree down without recursion by rotating left children up into the right spine
+  void destroy(Node *node)
+  {
+    while (node)
+    {
+      if (node->left)
+      {
+        Node *l = node->left;
+        node->left = l->right;
+        l->right = node;
+        node = l;
+      }
+      else
+      {
+        Node *next = node->right;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+public:
+  explicit BST(Balance p = Balance::NONE) : root(nullptr), policy(p) {}
+  ~BST() { destroy(root); }
+  BST(const BST &) = delete;
+  BST &operator=(const BST &) = delete;
+
+  void insert(int val)
+  {
+    switch (policy)
+    {
+    case Balance::NONE:
+      insertPlain(val);
+      break;
+    case Balance::AVL:
+      root = insertAVL(root, val);
+      break;
+    case Balance::RED_BLACK:
+      root = insertRB(root, val);
+      root->red = false;
+      break;
+    case Balance::SPLAY:
+      insertSplay(val);
+      break;
+    }
+  }
+  // Not const: in SPLAY mode a lookup restructures the tree
+  bool search(int val)
+  {
+    if (policy == Balance::SPLAY)
+    {
+      root = splay(root, val);
+      return root && root->data == val;
+    }
+    Node *curr = root;
+    while (curr)
+    {
+      if (val == curr->data)
+        return true;
+      curr = val < curr->data ? curr->left : curr->right;
+    }
+    return false;
+  }
+  // Height of the tree measured level by level (no recursion)
+  int treeHeight() const
+  {
+    int levels = 0;
+    vector<Node *> level;
+    if (root)
+      level.push_back(root);
+    while (!level.empty())
+    {
+      vector<Node *> next;
+      for (Node *node : level)
+      {
+        if (node->left)
+          next.push_back(node->left);
+        if (node->right)
+          next.push_back(node->right);
+      }
+      level.swap(next);
+      levels++;
+    }
+    return levels;
+  }
+  void inorder() const
+  {
+    vector<Node *> stack;
+    Node *curr = root;
+    while (curr || !stack.empty())
+    {
+      while (curr)
+      {
+        stack.push_back(curr);
+        curr = curr->left;
+      }
+      curr = stack.back();
+      stack.pop_back();
+      cout << curr->data << " ";
+      curr = curr->right;
+    }
+    cout << endl;
+  }
+};
+
+static const char *policyName(Balance p)
+{
+  switch (p)
+  {
+  case Balance::NONE:
+    return "NONE";
+  case Balance::AVL:
+    return "AVL";
+  case Balance::RED_BLACK:
+    return "RED_BLACK";
+  default:
+    return "SPLAY";
+  }
+}
+
+// Inserts 0..n-1 in increasing order, then looks every key up in random order
+static void benchmark(Balance p, int n)
+{
+  using Clock = chrono::steady_clock;
+  BST tree(p);
+  auto t0 = Clock::now();
+  for (int i = 0; i < n; i++)
+    tree.insert(i);
+  auto t1 = Clock::now();
+
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++)
+    keys[i] = i;
+  shuffle(keys.begin(), keys.end(), mt19937(42));
+
+  int found = 0;
+  auto t2 = Clock::now();
+  for (int key : keys)
+    found += tree.search(key);
+  auto t3 = Clock::now();
+
+  double insertMs = chrono::duration<double, milli>(t1 - t0).count();
+  double searchNs = chrono::duration<double, nano>(t3 - t2).count() / n;
+  cout << policyName(p) << ": n=" << n << " height=" << tree.treeHeight()
+       << " insert=" << insertMs << " ms search=" << searchNs << " ns/op"
+       << " found=" << found << endl;
+}
+
+// Builds a tree from n keys in random order, then replays a trace where the key of popularity
+// rank r is drawn with probability proportional to 1 / r^s
+static void zipfBenchmark(Balance p, int n, int accesses, double s)
+{
+  mt19937 rng(7);
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++)
+    keys[i] = i;
+  shuffle(keys.begin(), keys.end(), rng);
+  BST tree(p);
+  for (int key : keys)
+    tree.insert(key);
+
+  // Popularity ranks map to a different random permutation, so hot keys are scattered over the key range
+  shuffle(keys.begin(), keys.end(), rng);
+  vector<double> cdf(n);
+  double sum = 0;
+  for (int r = 0; r < n; r++)
+    cdf[r] = sum += 1.0 / pow(r + 1.0, s);
+  uniform_real_distribution<double> uniform(0, sum);
+  vector<int> trace(accesses);
+  for (int &key : trace)
+    key = keys[lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin()];
+
+  int found = 0;
+  auto t0 = chrono::steady_clock::now();
+  for (int key : trace)
+    found += tree.search(key);
+  auto t1 = chrono::steady_clock::now();
+  cout << policyName(p) << ": " << chrono::duration<double, nano>(t1 - t0).count() / accesses
+       << " ns/op found=" << found << endl;
+}
+
+// Usage: ./self_balancing_bst [n] [plain_n]
+int main(int argc, char **argv)
+{
+  BST avl(Balance::AVL), rb(Balance::RED_BLACK);
+  for (int val : {1, 2, 3, 4, 5, 6, 7})
+  {
+    avl.insert(val);
+    rb.insert(val);
+  }
+  cout << "AVL inorder: ";
+  avl.inorder();
+  cout << "AVL height after sorted inserts 1..7: " << avl.treeHeight() << endl;
+  cout << "Red-black height after sorted inserts 1..7: " << rb.treeHeight() << endl;
+
+  // The plain tree degrades to O(n^2) on sorted input, so it is measured at a smaller size
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int plainN = argc > 2 ? atoi(argv[2]) : 20000;
+  cout << "\n=== Sorted insert benchmark ===" << endl;
+  benchmark(Balance::NONE, plainN);
+  benchmark(Balance::AVL, plainN);
+  benchmark(Balance::AVL, n);
+  benchmark(Balance::RED_BLACK, n);
+  benchmark(Balance::SPLAY, n);
+
+  int accesses = 4 * n;
+  cout << "\n=== Zipf(1.1) search benchmark: " << n << " keys, " << accesses << " accesses ===" << endl;
+  for (Balance p : {Balance::NONE, Balance::AVL, Balance::RED_BLACK, Balance::SPLAY})
+    zipfBenchmark(p, n, accesses, 1.1);
+  return 0;
+}